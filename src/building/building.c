@@ -13,6 +13,7 @@
 #include "building/variant.h"
 #include "city/buildings.h"
 #include "city/finance.h"
+#include "city/labor.h"
 #include "city/population.h"
 #include "city/warning.h"
 #include "core/array.h"
@@ -29,7 +30,6 @@
 #include "map/elevation.h"
 #include "map/grid.h"
 #include "map/random.h"
-#include "map/routing_terrain.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
 
@@ -192,6 +192,7 @@ building *building_create(building_type type, int x, int y)
     b->size = props->size;
     b->created_sequence = extra.created_sequence++;
     b->sentiment.house_happiness = 100;
+    b->labor_category = city_labor_category_for_building_type(type);
 
     fill_adjacent_types(b);
 
@@ -256,6 +257,7 @@ void building_change_type(building *b, building_type type)
     }
     remove_adjacent_types(b);
     b->type = type;
+    b->labor_category = city_labor_category_for_building_type(type);
     fill_adjacent_types(b);
 }
 
@@ -306,7 +308,6 @@ void building_trim(void)
 
 void building_update_state(void)
 {
-    int land_recalc = 0;
     int wall_recalc = 0;
     int road_recalc = 0;
     int aqueduct_recalc = 0;
@@ -336,7 +337,6 @@ void building_update_state(void)
                 map_terrain_add(b->grid_offset, TERRAIN_ROAD);
                 road_recalc = 1;
             }
-            land_recalc = 1;
             building_delete(b);
         } else if (b->state == BUILDING_STATE_RUBBLE) {
             if (b->house_size) {
@@ -358,9 +358,6 @@ void building_update_state(void)
     if (aqueduct_recalc) {
         map_tiles_update_all_aqueducts(0);
     }
-    if (land_recalc) {
-        map_routing_update_land();
-    }
     if (road_recalc) {
         map_tiles_update_all_roads();
         map_tiles_update_all_highways();
@@ -12,6 +12,7 @@
 #include "map/property.h"
 #include "map/random.h"
 #include "map/terrain.h"
+#include "map/tiles.h"
 
 #define MAX_TILES 8
 
@@ -506,3 +507,14 @@ void building_connectable_update_connections(void)
         building_connectable_update_connections_for_type(connectable_buildings[i]);
     }
 }
+
+void building_connectable_update_marked_connections(void)
+{
+    for (int i = 0; i < MAX_CONNECTABLE_BUILDINGS; i++) {
+        for (building *b = building_first_of_type(connectable_buildings[i]); b; b = b->next_of_type) {
+            if (map_tiles_is_marked_for_update(b->grid_offset)) {
+                map_image_set(b->grid_offset, building_image_get(b));
+            }
+        }
+    }
+}
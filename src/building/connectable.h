@@ -34,6 +34,7 @@ int building_is_connectable(building_type type);
 int building_connectable_num_variants(building_type type);
 
 void building_connectable_update_connections(void);
+void building_connectable_update_marked_connections(void);
 void building_connectable_update_connections_for_type(building_type type);
 
 
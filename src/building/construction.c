@@ -24,6 +24,7 @@
 #include "core/config.h"
 #include "core/image.h"
 #include "figure/formation.h"
+#include "game/replay.h"
 #include "game/undo.h"
 #include "graphics/window.h"
 #include "map/aqueduct.h"
@@ -650,12 +651,8 @@ int building_construction_in_progress(void)
     return data.in_progress;
 }
 
-void building_construction_start(int x, int y, int grid_offset)
+static void start_construction(int x, int y, int grid_offset)
 {
-    if (data.type == BUILDING_HIGHWAY) {
-        building_construction_offset_start_from_orientation(&x, &y, 2);
-        grid_offset = map_grid_offset(x, y);
-    }
     data.start.grid_offset = grid_offset;
     data.start.x = data.end.x = x;
     data.start.y = data.end.y = y;
@@ -663,23 +660,24 @@ void building_construction_start(int x, int y, int grid_offset)
     if (game_undo_start_build(data.type)) {
         data.in_progress = 1;
         int can_start = 1;
+        map_routing_invalidate_building_distances();
         switch (data.type) {
             case BUILDING_ROAD:
-                can_start = map_routing_calculate_distances_for_building(
-                    ROUTED_BUILDING_ROAD, data.start.x, data.start.y);
+                can_start = map_routing_calculate_distances_for_building_to(
+                    ROUTED_BUILDING_ROAD, data.start.x, data.start.y, data.start.x, data.start.y);
                 break;
             case BUILDING_AQUEDUCT:
             case BUILDING_DRAGGABLE_RESERVOIR:
-                can_start = map_routing_calculate_distances_for_building(
-                    ROUTED_BUILDING_AQUEDUCT, data.start.x, data.start.y);
+                can_start = map_routing_calculate_distances_for_building_to(
+                    ROUTED_BUILDING_AQUEDUCT, data.start.x, data.start.y, data.start.x, data.start.y);
                 break;
             case BUILDING_WALL:
-                can_start = map_routing_calculate_distances_for_building(
-                    ROUTED_BUILDING_WALL, data.start.x, data.start.y);
+                can_start = map_routing_calculate_distances_for_building_to(
+                    ROUTED_BUILDING_WALL, data.start.x, data.start.y, data.start.x, data.start.y);
                 break;
             case BUILDING_HIGHWAY:
-                can_start = map_routing_calculate_distances_for_building(
-                    ROUTED_BUILDING_HIGHWAY, data.start.x, data.start.y);
+                can_start = map_routing_calculate_distances_for_building_to(
+                    ROUTED_BUILDING_HIGHWAY, data.start.x, data.start.y, data.start.x, data.start.y);
             default:
                 break;
         }
@@ -689,6 +687,15 @@ void building_construction_start(int x, int y, int grid_offset)
     }
 }
 
+void building_construction_start(int x, int y, int grid_offset)
+{
+    if (data.type == BUILDING_HIGHWAY) {
+        building_construction_offset_start_from_orientation(&x, &y, 2);
+        grid_offset = map_grid_offset(x, y);
+    }
+    start_construction(x, y, grid_offset);
+}
+
 int building_construction_is_updatable(void)
 {
     switch (data.type) {
@@ -998,6 +1005,7 @@ void building_construction_place(void)
     if (!type) {
         return;
     }
+    game_replay_record_construction(type, x_start, y_start, x_end, y_end);
     if (city_finance_out_of_money()) {
         map_property_clear_constructing_and_deleted();
         city_warning_show(WARNING_OUT_OF_MONEY, NEW_WARNING_SLOT);
@@ -1149,6 +1157,24 @@ void building_construction_place(void)
     game_undo_finish_build(placement_cost);
 }
 
+void building_construction_replay_place(int x_start, int y_start, int x_end, int y_end)
+{
+    start_construction(x_start, y_start, map_grid_offset(x_start, y_start));
+    if (!data.in_progress) {
+        return;
+    }
+    data.end.x = x_end;
+    data.end.y = y_end;
+    data.end.grid_offset = map_grid_offset(x_end, y_end);
+    building_construction_update(0, 0, 0);
+    if (data.type == BUILDING_LOW_BRIDGE || data.type == BUILDING_SHIP_BRIDGE) {
+        // the bridge length is otherwise only calculated while drawing the ghost
+        int length, direction;
+        map_bridge_calculate_length_direction(x_end, y_end, &length, &direction);
+    }
+    building_construction_place();
+}
+
 static void set_warning(int *warning_id, int warning)
 {
     if (warning_id) {
@@ -45,6 +45,8 @@ void building_construction_offset_start_from_orientation(int *x, int *y, int siz
 
 void building_construction_place(void);
 
+void building_construction_replay_place(int x_start, int y_start, int x_end, int y_end);
+
 int building_construction_can_place_on_terrain(int x, int y, int *warning_id);
 
 void building_construction_record_view_position(int view_x, int view_y, int grid_offset);
@@ -317,7 +317,7 @@ static void add_to_map(int type, building *b, int size, int orientation, int wat
             add_building(b);
             break;
     }
-    map_routing_update_land();
+    map_routing_update_land_dirty();
     map_routing_update_walls();
 }
 
@@ -6,6 +6,7 @@
 #include "core/config.h"
 #include "figure/roamer_preview.h"
 #include "figuretype/migrant.h"
+#include "game/replay.h"
 #include "game/undo.h"
 #include "graphics/window.h"
 #include "map/aqueduct.h"
@@ -196,6 +197,7 @@ static int clear_land_confirmed(int measure_only, int x_start, int y_start, int
         map_routing_update_walls();
         map_routing_update_water();
         building_update_state();
+        map_routing_update_land_dirty();
         figure_roamer_preview_reset(BUILDING_CLEAR_LAND);
         window_invalidate();
     }
@@ -209,6 +211,7 @@ static void confirm_delete_fort(int accepted, int checked)
     } else {
         confirm.fort_confirmed = -1;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     clear_land_confirmed(0, confirm.x_start, confirm.y_start, confirm.x_end, confirm.y_end);
 }
 
@@ -219,6 +222,7 @@ static void confirm_delete_bridge(int accepted, int checked)
     } else {
         confirm.bridge_confirmed = -1;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     clear_land_confirmed(0, confirm.x_start, confirm.y_start, confirm.x_end, confirm.y_end);
 }
 
@@ -229,6 +233,7 @@ static void confirm_delete_monument(int accepted, int checked)
     } else {
         confirm.monument_confirmed = -1;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     clear_land_confirmed(0, confirm.x_start, confirm.y_start, confirm.x_end, confirm.y_end);
 }
 
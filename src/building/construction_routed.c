@@ -100,7 +100,7 @@ int building_construction_place_road(int measure_only, int x_start, int y_start,
     }
 
     int items_placed = 0;
-    if (map_routing_calculate_distances_for_building(ROUTED_BUILDING_ROAD, x_start, y_start) &&
+    if (map_routing_calculate_distances_for_building_to(ROUTED_BUILDING_ROAD, x_start, y_start, x_end, y_end) &&
             place_routed_building(x_start, y_start, x_end, y_end, ROUTED_BUILDING_ROAD, &items_placed)) {
         if (!measure_only) {
             map_routing_update_land();
@@ -127,7 +127,7 @@ int building_construction_place_highway(int measure_only, int x_start, int y_sta
     }
 
     int items_placed = 0;
-    if (map_routing_calculate_distances_for_building(ROUTED_BUILDING_HIGHWAY, x_start, y_start) &&
+    if (map_routing_calculate_distances_for_building_to(ROUTED_BUILDING_HIGHWAY, x_start, y_start, x_end, y_end) &&
         place_routed_building(x_start, y_start, x_end, y_end, ROUTED_BUILDING_HIGHWAY, &items_placed)) {
         map_tiles_update_all_plazas();
         if (!measure_only) {
@@ -171,7 +171,7 @@ int building_construction_place_aqueduct(int x_start, int y_start, int x_end, in
     if (blocked) {
         return 0;
     }
-    if (!map_routing_calculate_distances_for_building(ROUTED_BUILDING_AQUEDUCT, x_start, y_start)) {
+    if (!map_routing_calculate_distances_for_building_to(ROUTED_BUILDING_AQUEDUCT, x_start, y_start, x_end, y_end)) {
         return 0;
     }
     int num_items;
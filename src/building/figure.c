@@ -2107,3 +2107,18 @@ void building_figure_generate(void)
         }
     }
 }
+
+void building_figure_clear_state(void)
+{
+    data.beggar_counter = 0;
+}
+
+void building_figure_save_state(buffer *buf)
+{
+    buffer_write_i32(buf, data.beggar_counter);
+}
+
+void building_figure_load_state(buffer *buf)
+{
+    data.beggar_counter = buffer_read_i32(buf);
+}
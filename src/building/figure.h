@@ -1,6 +1,14 @@
 #ifndef BUILDING_FIGURE_H
 #define BUILDING_FIGURE_H
 
+#include "core/buffer.h"
+
 void building_figure_generate(void);
 
+void building_figure_clear_state(void);
+
+void building_figure_save_state(buffer *buf);
+
+void building_figure_load_state(buffer *buf);
+
 #endif // BUILDING_FIGURE_H
@@ -133,6 +133,18 @@ int building_rotation_get_rotation_with_limit(int limit)
     return data.extra_rotation % limit;
 }
 
+int building_rotation_get_extra_rotation(void)
+{
+    return data.extra_rotation;
+}
+
+void building_rotation_set_rotation(int rotation, int extra_rotation, int road_orientation)
+{
+    data.rotation = rotation;
+    data.extra_rotation = extra_rotation;
+    data.road_orientation = road_orientation;
+}
+
 void building_rotation_rotate_forward(void)
 {
     if (building_rotation_type_has_rotations(building_construction_type())) {
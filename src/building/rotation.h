@@ -13,6 +13,10 @@ int building_rotation_get_rotation(void);
 
 int building_rotation_get_rotation_with_limit(int limit);
 
+int building_rotation_get_extra_rotation(void);
+
+void building_rotation_set_rotation(int rotation, int extra_rotation, int road_orientation);
+
 int building_rotation_get_corner(int rot);
 
 void building_rotation_rotate_forward(void);
@@ -3,6 +3,7 @@
 #include "building/industry.h"
 #include "building/monument.h"
 #include "building/roadblock.h"
+#include "city/labor.h"
 #include "figure/figure.h"
 #include "game/save_version.h"
 
@@ -470,7 +471,9 @@ void building_state_load_from_buffer(buffer *buf, building *b, int building_buf_
     b->house_sentiment_message = buffer_read_u8(buf);
     b->has_well_access = buffer_read_u8(buf);
     b->num_workers = buffer_read_i16(buf);
-    b->labor_category = buffer_read_u8(buf);
+    buffer_skip(buf, 1); // labor category, recalculated below since older saves may have a stale one
+    // unused buildings keep all zeroes, the same as when they are deleted
+    b->labor_category = b->state != BUILDING_STATE_UNUSED ? city_labor_category_for_building_type(b->type) : 0;
     b->output_resource_id = resource_remap(buffer_read_u8(buf));
     b->has_road_access = buffer_read_u8(buf);
     b->house_criminal_active = buffer_read_u8(buf);
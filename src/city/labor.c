@@ -10,6 +10,7 @@
 #include "city/population.h"
 #include "core/calc.h"
 #include "core/random.h"
+#include "game/replay.h"
 #include "game/time.h"
 #include "scenario/data.h"
 #include "scenario/property.h"
@@ -169,6 +170,7 @@ int city_labor_wages(void)
 
 void city_labor_change_wages(int amount)
 {
+    game_replay_record_command(REPLAY_COMMAND_WAGES, amount, 0);
     city_data.labor.wages += amount;
     city_data.labor.wages = calc_bound(city_data.labor.wages, 0, 100);
 }
@@ -265,29 +267,54 @@ static int should_have_workers(building *b, int category, int check_access)
     return 1;
 }
 
+static struct {
+    building_type types[BUILDING_TYPE_MAX];
+    int num_types;
+} category_types[LABOR_CATEGORY_MAX];
+
+static void init_category_types(void)
+{
+    static int initialized;
+    if (initialized) {
+        return;
+    }
+    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
+        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
+        if (cat != LABOR_CATEGORY_NONE) {
+            category_types[cat].types[category_types[cat].num_types++] = type;
+        }
+    }
+    initialized = 1;
+}
+
+int city_labor_category_for_building_type(building_type type)
+{
+    return CATEGORY_FOR_BUILDING_TYPE[type] - 1;
+}
+
 static void calculate_workers_needed_per_category(void)
 {
+    init_category_types();
     for (int cat = 0; cat < LABOR_CATEGORY_MAX; cat++) {
         city_data.labor.categories[cat].buildings = 0;
         city_data.labor.categories[cat].total_houses_covered = 0;
         city_data.labor.categories[cat].workers_allocated = 0;
         city_data.labor.categories[cat].workers_needed = 0;
     }
-    for (int i = 1; i < building_count(); i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int category = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        b->labor_category = category - 1;
-        if (!should_have_workers(b, category, 1)) {
-            continue;
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        labor_category_data *data = &city_data.labor.categories[cat - 1];
+        for (int i = 0; i < category_types[cat].num_types; i++) {
+            building_type type = category_types[cat].types[i];
+            int laborers = building_get_laborers(type);
+            for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+                if (b->state != BUILDING_STATE_IN_USE || !should_have_workers(b, cat, 1)) {
+                    continue;
+                }
+                data->workers_needed += laborers;
+                data->total_houses_covered += b->houses_covered;
+                data->buildings++;
+            }
         }
-
-        city_data.labor.categories[category - 1].workers_needed += building_get_laborers(b->type);
-
-        city_data.labor.categories[category - 1].total_houses_covered += b->houses_covered;
-        city_data.labor.categories[category - 1].buildings++;
     }
 }
 
@@ -389,75 +416,92 @@ static void check_employment(void)
 static void set_building_worker_weight(void)
 {
     int water_per_10k_per_building = calc_percentage(100, city_data.labor.categories[LABOR_CATEGORY_WATER - 1].buildings);
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_NONE) {
-            continue;
-        }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
-            if (cat == LABOR_CATEGORY_WATER) {
-                b->percentage_houses_covered = water_per_10k_per_building;
-            } else {
-                b->percentage_houses_covered = 0;
-                
-                if (b->houses_covered) {
-                    b->percentage_houses_covered =
-                        calc_percentage(100 * b->houses_covered,
-                        city_data.labor.categories[cat - 1].total_houses_covered);
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        int total_houses_covered = city_data.labor.categories[cat - 1].total_houses_covered;
+        for (int i = 0; i < category_types[cat].num_types; i++) {
+            for (building *b = building_first_of_type(category_types[cat].types[i]); b; b = b->next_of_type) {
+                if (b->state != BUILDING_STATE_IN_USE) {
+                    continue;
+                }
+                if (cat == LABOR_CATEGORY_WATER) {
+                    b->percentage_houses_covered = water_per_10k_per_building;
+                } else {
+                    b->percentage_houses_covered = 0;
+
+                    if (b->houses_covered) {
+                        b->percentage_houses_covered = calc_percentage(100 * b->houses_covered, total_houses_covered);
+                    }
                 }
             }
         }
     }
 }
 
+static struct {
+    int start_building_id;
+    int next_start_building_id;
+    int buildings_to_skip;
+    int workers_per_building;
+    int percentage_not_filled;
+} water_allocation = { 1 };
+
+static void allocate_workers_to_water_building(building *b)
+{
+    b->num_workers = 0;
+    if (b->percentage_houses_covered <= 0) {
+        return;
+    }
+    if (water_allocation.percentage_not_filled <= 0) {
+        b->num_workers = building_get_laborers(b->type);
+    } else if (water_allocation.buildings_to_skip) {
+        --water_allocation.buildings_to_skip;
+    } else {
+        if (!water_allocation.next_start_building_id) {
+            water_allocation.next_start_building_id = b->id;
+        }
+        b->num_workers = water_allocation.workers_per_building;
+    }
+}
+
 static void allocate_workers_to_water(void)
 {
-    static int start_building_id = 1;
     labor_category_data *water_cat = &city_data.labor.categories[LABOR_CATEGORY_WATER - 1];
 
-    int percentage_not_filled = 100 - calc_percentage(water_cat->workers_allocated, water_cat->workers_needed);
+    water_allocation.percentage_not_filled =
+        100 - calc_percentage(water_cat->workers_allocated, water_cat->workers_needed);
 
-    int buildings_to_skip = calc_adjust_with_percentage(water_cat->buildings, percentage_not_filled);
+    water_allocation.buildings_to_skip =
+        calc_adjust_with_percentage(water_cat->buildings, water_allocation.percentage_not_filled);
 
-    int workers_per_building;
-    if (buildings_to_skip == water_cat->buildings) {
-        workers_per_building = 1;
+    if (water_allocation.buildings_to_skip == water_cat->buildings) {
+        water_allocation.workers_per_building = 1;
     } else {
-        workers_per_building = water_cat->workers_allocated / (water_cat->buildings - buildings_to_skip);
-    }
-    int building_id = start_building_id;
-    start_building_id = 0;
-    for (int guard = 1; guard < building_count(); guard++, building_id++) {
-        if (building_id >= building_count()) {
-            building_id = 1;
-        }
-        building *b = building_get(building_id);
-        if (b->state != BUILDING_STATE_IN_USE || CATEGORY_FOR_BUILDING_TYPE[b->type] != LABOR_CATEGORY_WATER) {
-            continue;
-        }
-        b->num_workers = 0;
-        if (b->percentage_houses_covered > 0) {
-            if (percentage_not_filled > 0) {
-                if (buildings_to_skip) {
-                    --buildings_to_skip;
-                } else if (start_building_id) {
-                    b->num_workers = workers_per_building;
-                } else {
-                    start_building_id = building_id;
-                    b->num_workers = workers_per_building;
-                }
-            } else {
-                b->num_workers = building_get_laborers(b->type);
+        water_allocation.workers_per_building =
+            water_cat->workers_allocated / (water_cat->buildings - water_allocation.buildings_to_skip);
+    }
+    water_allocation.next_start_building_id = 0;
+
+    // the type lists are sorted by id: continue the round-robin from where the previous allocation started,
+    // then wrap around to the buildings before it
+    for (int i = 0; i < category_types[LABOR_CATEGORY_WATER].num_types; i++) {
+        for (building *b = building_first_of_type(category_types[LABOR_CATEGORY_WATER].types[i]); b;
+            b = b->next_of_type) {
+            if (b->state == BUILDING_STATE_IN_USE && b->id >= water_allocation.start_building_id) {
+                allocate_workers_to_water_building(b);
             }
         }
     }
-    if (!start_building_id) {
-        // no buildings assigned or full employment
-        start_building_id = 1;
+    for (int i = 0; i < category_types[LABOR_CATEGORY_WATER].num_types; i++) {
+        for (building *b = building_first_of_type(category_types[LABOR_CATEGORY_WATER].types[i]);
+            b && b->id < water_allocation.start_building_id; b = b->next_of_type) {
+            if (b->state == BUILDING_STATE_IN_USE) {
+                allocate_workers_to_water_building(b);
+            }
+        }
     }
+    // no buildings assigned or full employment restarts at the first building
+    water_allocation.start_building_id =
+        water_allocation.next_start_building_id ? water_allocation.next_start_building_id : 1;
 }
 
 static void allocate_workers_to_non_water_buildings(void)
@@ -470,33 +514,35 @@ static void allocate_workers_to_non_water_buildings(void)
             city_data.labor.categories[i].workers_allocated < city_data.labor.categories[i].workers_needed
             ? 1 : 0;
     }
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_NONE) {
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        if (cat == LABOR_CATEGORY_WATER) {
             // water is handled by allocate_workers_to_water(void)
             continue;
         }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
-            b->num_workers = 0;
-            if (b->type != BUILDING_LATRINES && (!should_have_workers(b, cat, 0) || b->percentage_houses_covered <= 0)) {
-                continue;
-            }
-            
-            int required_workers = model_get_building(b->type)->laborers;
-            if (category_workers_needed[cat - 1]) {
-                int num_workers = calc_adjust_with_percentage(
-                    city_data.labor.categories[cat - 1].workers_allocated,
-                    b->percentage_houses_covered) / 100;
-                if (num_workers > required_workers) {
-                    num_workers = required_workers;
+        for (int i = 0; i < category_types[cat].num_types; i++) {
+            building_type type = category_types[cat].types[i];
+            int required_workers = model_get_building(type)->laborers;
+            for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+                if (b->state != BUILDING_STATE_IN_USE) {
+                    continue;
+                }
+                b->num_workers = 0;
+                if (b->type != BUILDING_LATRINES &&
+                    (!should_have_workers(b, cat, 0) || b->percentage_houses_covered <= 0)) {
+                    continue;
+                }
+                if (category_workers_needed[cat - 1]) {
+                    int num_workers = calc_adjust_with_percentage(
+                        city_data.labor.categories[cat - 1].workers_allocated,
+                        b->percentage_houses_covered) / 100;
+                    if (num_workers > required_workers) {
+                        num_workers = required_workers;
+                    }
+                    b->num_workers = num_workers;
+                    category_workers_allocated[cat - 1] += num_workers;
+                } else {
+                    b->num_workers = required_workers;
                 }
-                b->num_workers = num_workers;
-                category_workers_allocated[cat - 1] += num_workers;
-            } else {
-                b->num_workers = required_workers;
             }
         }
     }
@@ -512,29 +558,26 @@ static void allocate_workers_to_non_water_buildings(void)
             }
         }
     }
-    for (building_type type = 0; type < BUILDING_TYPE_MAX; type++) {
-        int cat = CATEGORY_FOR_BUILDING_TYPE[type];
-        if (cat == LABOR_CATEGORY_NONE || cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY) {
+    for (int cat = LABOR_CATEGORY_NONE + 1; cat < LABOR_CATEGORY_MAX; cat++) {
+        if (cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY) {
             continue;
         }
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
-            if (!should_have_workers(b, cat, 0)) {
-                continue;
-            }
-            if (b->percentage_houses_covered > 0 && category_workers_needed[cat - 1]) {
-                int required_workers = model_get_building(b->type)->laborers;
-                if (b->num_workers < required_workers) {
-                    int needed = required_workers - b->num_workers;
-                    if (needed > category_workers_needed[cat - 1]) {
-                        b->num_workers += category_workers_needed[cat - 1];
-                        category_workers_needed[cat - 1] = 0;
-                    } else {
-                        b->num_workers += needed;
-                        category_workers_needed[cat - 1] -= needed;
-                    }
+        for (int i = 0; i < category_types[cat].num_types && category_workers_needed[cat - 1]; i++) {
+            building_type type = category_types[cat].types[i];
+            int required_workers = model_get_building(type)->laborers;
+            for (building *b = building_first_of_type(type); b && category_workers_needed[cat - 1];
+                b = b->next_of_type) {
+                if (b->state != BUILDING_STATE_IN_USE || b->percentage_houses_covered <= 0 ||
+                    b->num_workers >= required_workers || !should_have_workers(b, cat, 0)) {
+                    continue;
+                }
+                int needed = required_workers - b->num_workers;
+                if (needed > category_workers_needed[cat - 1]) {
+                    b->num_workers += category_workers_needed[cat - 1];
+                    category_workers_needed[cat - 1] = 0;
+                } else {
+                    b->num_workers += needed;
+                    category_workers_needed[cat - 1] -= needed;
                 }
             }
         }
@@ -550,6 +593,7 @@ static void allocate_workers_to_buildings(void)
 
 void city_labor_allocate_workers(void)
 {
+    init_category_types();
     allocate_workers_to_categories();
     allocate_workers_to_buildings();
 }
@@ -563,6 +607,7 @@ void city_labor_update(void)
 
 void city_labor_set_priority(int category, int new_priority)
 {
+    game_replay_record_command(REPLAY_COMMAND_LABOR_PRIORITY, category, new_priority);
     int old_priority = city_data.labor.categories[category].priority;
     if (old_priority == new_priority) {
         return;
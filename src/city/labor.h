@@ -1,6 +1,8 @@
 #ifndef CITY_LABOR_H
 #define CITY_LABOR_H
 
+#include "building/type.h"
+
 typedef struct {
     int workers_needed;
     int workers_allocated;
@@ -25,6 +27,11 @@ int city_labor_lower_wages_rome(void);
 
 const labor_category_data *city_labor_category(int category);
 
+/**
+ * Returns the labor category index of the building type, or -1 if the type does not employ workers
+ */
+int city_labor_category_for_building_type(building_type type);
+
 void city_labor_calculate_workers(int num_plebs, int num_patricians);
 
 void city_labor_allocate_workers(void);
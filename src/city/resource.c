@@ -18,6 +18,7 @@
 #include "figure/figure.h"
 #include "figure/formation.h"
 #include "game/difficulty.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "game/tutorial.h"
 #include "map/road_access.h"
@@ -171,6 +172,7 @@ resource_trade_status city_resource_trade_status(resource_type resource)
 
 void city_resource_cycle_trade_status(resource_type resource, resource_trade_status status)
 {
+    game_replay_record_command(REPLAY_COMMAND_TRADE_STATUS, resource, status);
     if (status == TRADE_STATUS_IMPORT && !empire_can_import_resource(resource)) {
         city_data.resource.trade_status[resource] &= ~TRADE_STATUS_IMPORT;
         return;
@@ -193,6 +195,7 @@ int city_resource_import_over(resource_type resource)
 
 void city_resource_change_import_over(resource_type resource, int change)
 {
+    game_replay_record_command(REPLAY_COMMAND_IMPORT_OVER, resource, change);
     city_data.resource.import_over[resource] = calc_bound(city_data.resource.import_over[resource] + change, 0, 100);
 }
 
@@ -203,6 +206,7 @@ int city_resource_export_over(resource_type resource)
 
 void city_resource_change_export_over(resource_type resource, int change)
 {
+    game_replay_record_command(REPLAY_COMMAND_EXPORT_OVER, resource, change);
     city_data.resource.export_over[resource] = calc_bound(city_data.resource.export_over[resource] + change, 0, 100);
 }
 
@@ -213,6 +217,7 @@ int city_resource_is_stockpiled(resource_type resource)
 
 void city_resource_toggle_stockpiled(resource_type resource)
 {
+    game_replay_record_command(REPLAY_COMMAND_STOCKPILE, resource, 0);
     if (city_data.resource.stockpiled[resource]) {
         city_data.resource.stockpiled[resource] = 0;
         city_data.resource.trade_status[resource] |= city_data.resource.export_status_before_stockpiling[resource];
@@ -230,6 +235,7 @@ int city_resource_is_mothballed(resource_type resource)
 
 void city_resource_toggle_mothballed(resource_type resource)
 {
+    game_replay_record_command(REPLAY_COMMAND_MOTHBALL, resource, 0);
     city_data.resource.mothballed[resource] = city_data.resource.mothballed[resource] ? 0 : 1;
 }
 
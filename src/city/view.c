@@ -11,6 +11,8 @@
 #include "map/image.h"
 #include "widget/minimap.h"
 
+#include <stdlib.h>
+
 #define TILE_WIDTH_PIXELS 60
 #define TILE_HEIGHT_PIXELS 30
 #define HALF_TILE_WIDTH_PIXELS 30
@@ -45,6 +47,34 @@ static struct {
 
 static int view_to_grid_offset_lookup[VIEW_X_MAX][VIEW_Y_MAX];
 
+typedef struct {
+    int x;
+    int y;
+    int grid_offset;
+} visible_tile;
+
+// The valid tiles in view with their screen position, in drawing order. The view is drawn in several passes
+// every frame, so the tiles are only looked up again when the camera, the viewport or the lookup changes.
+static struct {
+    int is_current;
+    struct {
+        view_tile tile;
+        pixel_offset pixel;
+    } camera;
+    struct {
+        int x;
+        int y;
+        int width_tiles;
+        int height_tiles;
+    } viewport;
+    visible_tile *tiles;
+    int num_tiles;
+    int tile_capacity;
+    int *row_starts;
+    int num_rows;
+    int row_capacity;
+} visible_tiles;
+
 static void check_camera_boundaries(void)
 {
     int max_scale = city_view_get_max_scale();
@@ -95,6 +125,7 @@ static void check_camera_boundaries(void)
 
 static void reset_lookup(void)
 {
+    visible_tiles.is_current = 0;
     for (int y = 0; y < VIEW_Y_MAX; y++) {
         for (int x = 0; x < VIEW_X_MAX; x++) {
             view_to_grid_offset_lookup[x][y] = -1;
@@ -695,12 +726,55 @@ void city_view_load_scenario_state(buffer *camera)
     data.camera.tile.y = buffer_read_i32(camera);
 }
 
-void city_view_foreach_valid_map_tile(map_callback *callback)
+static int visible_tiles_are_current(void)
+{
+    return visible_tiles.is_current &&
+        visible_tiles.camera.tile.x == data.camera.tile.x && visible_tiles.camera.tile.y == data.camera.tile.y &&
+        visible_tiles.camera.pixel.x == data.camera.pixel.x && visible_tiles.camera.pixel.y == data.camera.pixel.y &&
+        visible_tiles.viewport.x == data.viewport.x && visible_tiles.viewport.y == data.viewport.y &&
+        visible_tiles.viewport.width_tiles == data.viewport.width_tiles &&
+        visible_tiles.viewport.height_tiles == data.viewport.height_tiles;
+}
+
+static int reserve_visible_tiles(int num_rows, int num_tiles)
+{
+    if (num_rows + 1 > visible_tiles.row_capacity) {
+        int *row_starts = realloc(visible_tiles.row_starts, sizeof(int) * (num_rows + 1));
+        if (!row_starts) {
+            return 0;
+        }
+        visible_tiles.row_starts = row_starts;
+        visible_tiles.row_capacity = num_rows + 1;
+    }
+    if (num_tiles > visible_tiles.tile_capacity) {
+        visible_tile *tiles = realloc(visible_tiles.tiles, sizeof(visible_tile) * num_tiles);
+        if (!tiles) {
+            return 0;
+        }
+        visible_tiles.tiles = tiles;
+        visible_tiles.tile_capacity = num_tiles;
+    }
+    return 1;
+}
+
+static int update_visible_tiles(void)
 {
+    if (visible_tiles_are_current()) {
+        return 1;
+    }
+    int num_rows = data.viewport.height_tiles + 21;
+    int num_columns = data.viewport.width_tiles + 9;
+    if (!reserve_visible_tiles(num_rows, num_rows * num_columns)) {
+        visible_tiles.is_current = 0;
+        return 0;
+    }
+    visible_tiles.num_rows = 0;
+    visible_tiles.num_tiles = 0;
     int odd = 0;
     int y_view = data.camera.tile.y - 8;
     int y_graphic = data.viewport.y - 9 * HALF_TILE_HEIGHT_PIXELS - data.camera.pixel.y;
-    for (int y = 0; y < data.viewport.height_tiles + 21; y++) {
+    for (int y = 0; y < num_rows; y++) {
+        visible_tiles.row_starts[visible_tiles.num_rows++] = visible_tiles.num_tiles;
         if (y_view >= 0 && y_view < VIEW_Y_MAX) {
             int x_graphic = -(6 * TILE_WIDTH_PIXELS) - data.camera.pixel.x;
             if (odd) {
@@ -709,11 +783,14 @@ void city_view_foreach_valid_map_tile(map_callback *callback)
                 x_graphic += data.viewport.x;
             }
             int x_view = data.camera.tile.x - 6;
-            for (int x = 0; x < data.viewport.width_tiles + 9; x++) {
+            for (int x = 0; x < num_columns; x++) {
                 if (x_view >= 0 && x_view < VIEW_X_MAX) {
                     int grid_offset = view_to_grid_offset_lookup[x_view][y_view];
                     if (grid_offset >= 0) {
-                        callback(x_graphic, y_graphic, grid_offset);
+                        visible_tile *tile = &visible_tiles.tiles[visible_tiles.num_tiles++];
+                        tile->x = x_graphic;
+                        tile->y = y_graphic;
+                        tile->grid_offset = grid_offset;
                     }
                 }
                 x_graphic += TILE_WIDTH_PIXELS;
@@ -724,77 +801,53 @@ void city_view_foreach_valid_map_tile(map_callback *callback)
         y_graphic += HALF_TILE_HEIGHT_PIXELS;
         y_view++;
     }
+    visible_tiles.row_starts[visible_tiles.num_rows] = visible_tiles.num_tiles;
+
+    visible_tiles.camera.tile = data.camera.tile;
+    visible_tiles.camera.pixel = data.camera.pixel;
+    visible_tiles.viewport.x = data.viewport.x;
+    visible_tiles.viewport.y = data.viewport.y;
+    visible_tiles.viewport.width_tiles = data.viewport.width_tiles;
+    visible_tiles.viewport.height_tiles = data.viewport.height_tiles;
+    visible_tiles.is_current = 1;
+    return 1;
+}
+
+static void foreach_visible_tile_in_rows(int first_row, int last_row, map_callback *callback)
+{
+    // the list is indexed on every step, since a callback may cause it to be rebuilt
+    for (int i = visible_tiles.row_starts[first_row]; i < visible_tiles.row_starts[last_row + 1]; i++) {
+        const visible_tile *tile = &visible_tiles.tiles[i];
+        callback(tile->x, tile->y, tile->grid_offset);
+    }
+}
+
+void city_view_foreach_valid_map_tile(map_callback *callback)
+{
+    if (!update_visible_tiles() || !visible_tiles.num_rows) {
+        return;
+    }
+    foreach_visible_tile_in_rows(0, visible_tiles.num_rows - 1, callback);
 }
 
 void city_view_foreach_valid_map_tile_row(map_callback *callback1, map_callback *callback2, map_callback *callback3)
 {
-    int odd = 0;
-    int y_view = data.camera.tile.y - 8;
-    int y_graphic = data.viewport.y - 9 * HALF_TILE_HEIGHT_PIXELS - data.camera.pixel.y;
-    int x_graphic, x_view;
-    for (int y = 0; y < data.viewport.height_tiles + 21; y++) {
-        if (y_view >= 0 && y_view < VIEW_Y_MAX) {
-            if (callback1) {
-                x_graphic = -(6 * TILE_WIDTH_PIXELS) - data.camera.pixel.x;
-                if (odd) {
-                    x_graphic += data.viewport.x - HALF_TILE_WIDTH_PIXELS;
-                } else {
-                    x_graphic += data.viewport.x;
-                }
-                x_view = data.camera.tile.x - 6;
-                for (int x = 0; x < data.viewport.width_tiles + 9; x++) {
-                    if (x_view >= 0 && x_view < VIEW_X_MAX) {
-                        int grid_offset = view_to_grid_offset_lookup[x_view][y_view];
-                        if (grid_offset >= 0) {
-                            callback1(x_graphic, y_graphic, grid_offset);
-                        }
-                    }
-                    x_graphic += TILE_WIDTH_PIXELS;
-                    x_view++;
-                }
-            }
-            if (callback2) {
-                x_graphic = -(6 * TILE_WIDTH_PIXELS) - data.camera.pixel.x;
-                if (odd) {
-                    x_graphic += data.viewport.x - HALF_TILE_WIDTH_PIXELS;
-                } else {
-                    x_graphic += data.viewport.x;
-                }
-                x_view = data.camera.tile.x - 6;
-                for (int x = 0; x < data.viewport.width_tiles + 9; x++) {
-                    if (x_view >= 0 && x_view < VIEW_X_MAX) {
-                        int grid_offset = view_to_grid_offset_lookup[x_view][y_view];
-                        if (grid_offset >= 0) {
-                            callback2(x_graphic, y_graphic, grid_offset);
-                        }
-                    }
-                    x_graphic += TILE_WIDTH_PIXELS;
-                    x_view++;
-                }
-            }
-            if (callback3) {
-                x_graphic = -(6 * TILE_WIDTH_PIXELS) - data.camera.pixel.x;
-                if (odd) {
-                    x_graphic += data.viewport.x - HALF_TILE_WIDTH_PIXELS;
-                } else {
-                    x_graphic += data.viewport.x;
-                }
-                x_view = data.camera.tile.x - 6;
-                for (int x = 0; x < data.viewport.width_tiles + 9; x++) {
-                    if (x_view >= 0 && x_view < VIEW_X_MAX) {
-                        int grid_offset = view_to_grid_offset_lookup[x_view][y_view];
-                        if (grid_offset >= 0) {
-                            callback3(x_graphic, y_graphic, grid_offset);
-                        }
-                    }
-                    x_graphic += TILE_WIDTH_PIXELS;
-                    x_view++;
-                }
-            }
+    if (!update_visible_tiles()) {
+        return;
+    }
+    for (int row = 0; row < visible_tiles.num_rows; row++) {
+        if (visible_tiles.row_starts[row] == visible_tiles.row_starts[row + 1]) {
+            continue;
+        }
+        if (callback1) {
+            foreach_visible_tile_in_rows(row, row, callback1);
+        }
+        if (callback2) {
+            foreach_visible_tile_in_rows(row, row, callback2);
+        }
+        if (callback3) {
+            foreach_visible_tile_in_rows(row, row, callback3);
         }
-        odd = 1 - odd;
-        y_graphic += HALF_TILE_HEIGHT_PIXELS;
-        y_view++;
     }
 }
 
@@ -76,6 +76,8 @@ static const char *ini_keys[] = {
     "ui_show_speedrun_info",
     "ui_show_desirability_range",
     "ui_draw_asclepius",
+    "general_delta_autosaves",
+    "general_undo_history_memory",
 };
 
 static const char *ini_string_keys[] = {
@@ -102,6 +104,7 @@ static int default_values[CONFIG_MAX_ENTRIES] = {
     [CONFIG_SCREEN_CURSOR_SCALE] = 100,
     [CONFIG_GP_CH_MAX_GRAND_TEMPLES] = 2,    
     [CONFIG_UI_SHOW_DESIRABILITY_RANGE] = 0,
+    [CONFIG_GENERAL_UNDO_HISTORY_MEMORY] = 8,
 };
 
 static const char default_string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX] = { 0 };
@@ -66,6 +66,8 @@ typedef enum {
     CONFIG_UI_SHOW_SPEEDRUN_INFO,    
     CONFIG_UI_SHOW_DESIRABILITY_RANGE,
     CONFIG_UI_DRAW_ASCLEPIUS,
+    CONFIG_GENERAL_DELTA_AUTOSAVES,
+    CONFIG_GENERAL_UNDO_HISTORY_MEMORY,
     CONFIG_MAX_ENTRIES
 } config_key;
 
@@ -0,0 +1,179 @@
+#include "delta_rle.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define MAX_LITERAL_RUN 128
+#define MIN_REPEAT_RUN 3
+#define MAX_REPEAT_RUN (127 + MIN_REPEAT_RUN)
+#define REPEAT_FLAG 0x80
+#define STRIDE_SAMPLE_STEP 7
+
+static const int STRIDES[] = { 1, 2, 4 };
+
+static uint8_t delta_at(const uint8_t *input, int index, int stride)
+{
+    return index < stride ? input[index] : (uint8_t) (input[index] - input[index - stride]);
+}
+
+/**
+ * Picks the stride with the most sampled bytes that continue a run of equal differences,
+ * which is a cheap estimate of the stride that compresses best
+ */
+static int pick_stride(const uint8_t *input, int input_length)
+{
+    // a sample is enough: the step is odd so that it still covers every byte of 2 and 4 byte values
+    int repeated[3] = { 0, 0, 0 };
+    for (int i = 5; i < input_length; i += STRIDE_SAMPLE_STEP) {
+        repeated[0] += (uint8_t) (input[i] - input[i - 1]) == (uint8_t) (input[i - 1] - input[i - 2]);
+        repeated[1] += (uint8_t) (input[i] - input[i - 2]) == (uint8_t) (input[i - 1] - input[i - 3]);
+        repeated[2] += (uint8_t) (input[i] - input[i - 4]) == (uint8_t) (input[i - 1] - input[i - 5]);
+    }
+    int best = 0;
+    for (int i = 1; i < 3; i++) {
+        if (repeated[i] > repeated[best]) {
+            best = i;
+        }
+    }
+    return STRIDES[best];
+}
+
+static int write_literals(const uint8_t *input, int start, int end, int stride,
+    uint8_t *output, int output_index, int output_buffer_length)
+{
+    while (start < end) {
+        int count = end - start;
+        if (count > MAX_LITERAL_RUN) {
+            count = MAX_LITERAL_RUN;
+        }
+        if (output_index + 1 + count > output_buffer_length) {
+            return -1;
+        }
+        output[output_index] = (uint8_t) (count - 1);
+        for (int i = 0; i < count; i++) {
+            output[output_index + 1 + i] = delta_at(input, start + i, stride);
+        }
+        output_index += 1 + count;
+        start += count;
+    }
+    return output_index;
+}
+
+/**
+ * Encodes the input with the given stride.
+ * Returns the encoded length, or -1 when it does not fit in output_buffer_length.
+ */
+static int encode(const uint8_t *input, int input_length, int stride, uint8_t *output, int output_buffer_length)
+{
+    if (output_buffer_length < 1) {
+        return -1;
+    }
+    output[0] = (uint8_t) stride;
+    int output_index = 1;
+    int literal_start = 0;
+    int index = 0;
+    while (index < input_length) {
+        uint8_t value = delta_at(input, index, stride);
+        int run = 1;
+        while (index + run < input_length && run < MAX_REPEAT_RUN && delta_at(input, index + run, stride) == value) {
+            run++;
+        }
+        if (run < MIN_REPEAT_RUN) {
+            index += run;
+            continue;
+        }
+        output_index = write_literals(input, literal_start, index, stride, output, output_index, output_buffer_length);
+        if (output_index < 0 || output_index + 2 > output_buffer_length) {
+            return -1;
+        }
+        output[output_index] = (uint8_t) (REPEAT_FLAG | (run - MIN_REPEAT_RUN));
+        output[output_index + 1] = value;
+        output_index += 2;
+        index += run;
+        literal_start = index;
+    }
+    return write_literals(input, literal_start, input_length, stride, output, output_index, output_buffer_length);
+}
+
+int delta_rle_compress(const void *input_buffer, int input_length,
+    void *output_buffer, int output_buffer_length, int *output_length)
+{
+    const uint8_t *input = input_buffer;
+    // a single encoding with the most promising stride is much faster than trying all of them
+    int length = encode(input, input_length, pick_stride(input, input_length), output_buffer, output_buffer_length);
+    if (length < 0) {
+        return 0;
+    }
+    *output_length = length;
+    return 1;
+}
+
+/**
+ * Repeats the previous stride bytes, copying blocks that grow as the repeated part grows
+ */
+static void repeat_previous(uint8_t *output, int index, int count, int stride)
+{
+    if (stride == 1) {
+        memset(&output[index], output[index - 1], count);
+        return;
+    }
+    int distance = stride;
+    while (count > 0) {
+        int block = count < distance ? count : distance;
+        memcpy(&output[index], &output[index - distance], block);
+        index += block;
+        count -= block;
+        distance += block;
+    }
+}
+
+int delta_rle_decompress(const void *input_buffer, int input_length,
+    void *output_buffer, int output_buffer_length, int *output_length)
+{
+    const uint8_t *input = input_buffer;
+    uint8_t *output = output_buffer;
+    if (input_length < 1) {
+        return 0;
+    }
+    int stride = input[0];
+    if (stride != 1 && stride != 2 && stride != 4) {
+        return 0;
+    }
+    int input_index = 1;
+    int output_index = 0;
+    // the differences are added up while decoding, so the output is only written once
+    while (input_index < input_length) {
+        int control = input[input_index++];
+        if (control & REPEAT_FLAG) {
+            int run = (control & ~REPEAT_FLAG) + MIN_REPEAT_RUN;
+            if (input_index >= input_length || output_index + run > output_buffer_length) {
+                return 0;
+            }
+            uint8_t delta = input[input_index++];
+            for (; run > 0 && output_index < stride; run--, output_index++) {
+                output[output_index] = delta;
+            }
+            if (delta == 0) {
+                repeat_previous(output, output_index, run, stride);
+                output_index += run;
+            } else {
+                for (; run > 0; run--, output_index++) {
+                    output[output_index] = (uint8_t) (output[output_index - stride] + delta);
+                }
+            }
+        } else {
+            int count = control + 1;
+            if (input_index + count > input_length || output_index + count > output_buffer_length) {
+                return 0;
+            }
+            for (; count > 0 && output_index < stride; count--, output_index++) {
+                output[output_index] = input[input_index++];
+            }
+            for (; count > 0; count--, output_index++) {
+                output[output_index] = (uint8_t) (output[output_index - stride] + input[input_index++]);
+            }
+        }
+    }
+    *output_length = output_index;
+    return output_index == output_buffer_length;
+}
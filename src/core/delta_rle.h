@@ -0,0 +1,35 @@
+#ifndef CORE_DELTA_RLE_H
+#define CORE_DELTA_RLE_H
+
+/**
+ * @file
+ * Fast codec for map grids and other data with long runs of equal or evenly changing values.
+ * Every byte is stored as the difference to the byte one element before it, and the differences
+ * are run-length encoded. The element size is picked automatically from 1, 2 and 4 bytes.
+ */
+
+/**
+ * Compresses the data
+ * @param input_buffer Data to compress
+ * @param input_length Length of the data
+ * @param output_buffer Buffer for the compressed data
+ * @param output_buffer_length Size of the output buffer
+ * @param output_length Will be set to the length of the compressed data
+ * @return 1 on success, 0 if the compressed data does not fit in the output buffer
+ */
+int delta_rle_compress(const void *input_buffer, int input_length,
+    void *output_buffer, int output_buffer_length, int *output_length);
+
+/**
+ * Decompresses the data
+ * @param input_buffer Compressed data
+ * @param input_length Length of the compressed data
+ * @param output_buffer Buffer for the decompressed data
+ * @param output_buffer_length Size of the output buffer, which must match the decompressed length
+ * @param output_length Will be set to the length of the decompressed data
+ * @return 1 on success, 0 if the data is invalid or does not fill the output buffer exactly
+ */
+int delta_rle_decompress(const void *input_buffer, int input_length,
+    void *output_buffer, int output_buffer_length, int *output_length);
+
+#endif // CORE_DELTA_RLE_H
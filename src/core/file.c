@@ -28,6 +28,16 @@ int file_close(FILE *stream)
     return platform_file_manager_close_file(stream);
 }
 
+void *file_map(FILE *stream, size_t *size)
+{
+    return platform_file_manager_map_file(stream, size);
+}
+
+void file_unmap(void *data, size_t size)
+{
+    platform_file_manager_unmap_file(data, size);
+}
+
 int file_has_extension(const char *filename, const char *extension)
 {
     if (!extension || !*extension) {
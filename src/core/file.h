@@ -41,6 +41,21 @@ FILE *file_open_asset(const char *asset, const char *mode);
  */
 int file_close(FILE *stream);
 
+/**
+ * Maps the contents of an open file to memory for reading
+ * @param stream File to map
+ * @param size Will be set to the size of the file
+ * @return Pointer to the read-only file contents, or 0 if the file could not be mapped
+ */
+void *file_map(FILE *stream, size_t *size);
+
+/**
+ * Unmaps a file mapped with file_map
+ * @param data Pointer returned by file_map
+ * @param size Size of the file
+ */
+void file_unmap(void *data, size_t size);
+
 /**
  * Checks whether the file has the given extension
  * @param filename Filename to check
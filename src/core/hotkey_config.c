@@ -128,6 +128,8 @@ static const char *ini_keys[] = {
     "show_overlay_native",
     "build_highway",
     "show_overlay_enemy",
+    "toggle_performance_overlay",
+    "save_performance_trace",
 };
 
 static struct {
@@ -231,6 +233,8 @@ static void init_defaults(void)
     set_mapping(KEY_TYPE_F7, KEY_MOD_NONE, HOTKEY_RESIZE_TO_640);
     set_mapping(KEY_TYPE_F8, KEY_MOD_NONE, HOTKEY_RESIZE_TO_800);
     set_mapping(KEY_TYPE_F9, KEY_MOD_NONE, HOTKEY_RESIZE_TO_1024);
+    set_mapping(KEY_TYPE_F11, KEY_MOD_NONE, HOTKEY_TOGGLE_PERFORMANCE_OVERLAY);
+    set_mapping(KEY_TYPE_F11, KEY_MOD_CTRL, HOTKEY_SAVE_PERFORMANCE_TRACE);
     set_mapping(KEY_TYPE_F12, KEY_MOD_NONE, HOTKEY_SAVE_SCREENSHOT);
     set_mapping(KEY_TYPE_F12, KEY_MOD_ALT, HOTKEY_SAVE_SCREENSHOT); // mac specific
     set_mapping(KEY_TYPE_F12, KEY_MOD_CTRL, HOTKEY_SAVE_CITY_SCREENSHOT);
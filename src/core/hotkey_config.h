@@ -114,6 +114,8 @@ typedef enum {
     HOTKEY_SHOW_OVERLAY_RISKS_NATIVE,
     HOTKEY_BUILD_HIGHWAY,
     HOTKEY_SHOW_OVERLAY_ENEMY,
+    HOTKEY_TOGGLE_PERFORMANCE_OVERLAY,
+    HOTKEY_SAVE_PERFORMANCE_TRACE,
     HOTKEY_MAX_ITEMS
 } hotkey_action;
 
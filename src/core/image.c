@@ -2,10 +2,12 @@
 
 #include "assets/assets.h"
 #include "core/buffer.h"
+#include "core/calc.h"
 #include "core/file.h"
 #include "core/image_packer.h"
 #include "core/io.h"
 #include "core/log.h"
+#include "core/performance.h"
 #include "graphics/font.h"
 #include "graphics/renderer.h"
 
@@ -36,6 +38,9 @@
 #define KOREAN_FONT_DATA_SIZE 7500000
 #define JAPANESE_FONT_DATA_SIZE 11000000
 
+#define MULTIBYTE_FONT_ATLAS_SIZE 1024
+#define NO_ATLAS_SLOT -1
+
 #define CYRILLIC_FONT_BASE_OFFSET 201
 #define GREEK_FONT_BASE_OFFSET 1
 
@@ -242,6 +247,33 @@ static struct {
     int max_image_height;
 } data;
 
+// Multibyte letters are only read from the font file when first measured, and only put in the font atlas
+// when drawn. The atlas is a single page of equal slots that are reused for the least recently drawn letters.
+static struct {
+    uint8_t *file_data;
+    int file_size;
+    int file_version;
+    const multibyte_font_sizes *sizes;
+    int letter_spacing;
+    int num_chars;
+    int num_half_width;
+    int style_offsets[FONT_STYLES];
+    uint8_t *letter_sizes_known;
+    int *letter_slots;
+    color_t *letter_pixels;
+    struct {
+        int letter;
+        int prev;
+        int next;
+    } *slots;
+    int num_slots;
+    int first_slot;
+    int last_slot;
+    int slots_per_row;
+    int slot_width;
+    int slot_height;
+} multibyte_font;
+
 static void read_header(buffer *buf)
 {
     buffer_skip(buf, 80); // header integers
@@ -716,11 +748,14 @@ int image_load_climate(int climate_id, int is_editor, int force_reload, int keep
     return 1;
 }
 
+static void free_multibyte_font(void);
+
 static void free_font_memory(void)
 {
     graphics_renderer()->free_image_atlas(ATLAS_FONT);
     free(data.font);
     data.font = 0;
+    free_multibyte_font();
     data.fonts_enabled = NO_EXTRA_FONT;
 }
 
@@ -800,92 +835,44 @@ static int load_external_fonts(int base_offset)
     return 1;
 }
 
-static int parse_4bit_multibyte_font(buffer *input, color_t *pixels, multibyte_font_sizes *font_size,
-    int letter_spacing, int num_chars, int num_half_width, int offset)
+static void set_multibyte_letter_size(image *img, int width, int height,
+    int x_first_opaque, int x_last_opaque, int y_first_opaque, int y_last_opaque)
 {
-    int pixel_offset = 0;
-    for (int i = 0; i < num_chars; i++) {
-        int width = i < num_half_width ? font_size->half_width : font_size->width;
-        color_t *letter = &pixels[pixel_offset];
-        int x_first_opaque = width;
-        int x_last_opaque = -1;
-        int y_first_opaque = font_size->height;
-        int y_last_opaque = -1;
-        for (int row = 0; row < font_size->height; row++) {
-            color_t *pixel = &letter[row * width];
-            uint8_t bits = 0;
-            for (int col = 0; col < font_size->width - letter_spacing; col++) {
-                if (col % 2 == 0) {
-                    bits = buffer_read_u8(input);
-                }
-                if (col < width) {
-                    uint8_t value = bits & 0xf;
-                    if (value != 0) {
-                        uint32_t color_value = (value * 16 + value);
-                        *pixel = (color_value << COLOR_BITSHIFT_ALPHA) | COLOR_CHANNEL_RGB;
-                        if (col < x_first_opaque) {
-                            x_first_opaque = col;
-                        }
-                        if (col > x_last_opaque) {
-                            x_last_opaque = col;
-                        }
-                        if (row < y_first_opaque) {
-                            y_first_opaque = row;
-                        }
-                        y_last_opaque = row;
-                    }
-                    pixel++;
-                }
-                bits >>= 4;
-            }
-        }
-        image *img = &data.font[offset + i];
-        img->width = x_last_opaque - x_first_opaque + 1;
-        img->x_offset = x_first_opaque;
-        img->original.width = width;
-        img->original.height = font_size->height;
-        img->y_offset = y_first_opaque;
-        img->height = y_last_opaque - y_first_opaque + 1;
-
-        if (img->width < 0) {
-            img->width = 0;
-        }
-        if (img->height < 0) {
-            img->height = 0;
-        }
-
-        image_packer_rect *rect = &data.packer.rects[offset + i];
-        rect->input.width = img->width;
-        rect->input.height = img->height;
+    img->width = x_last_opaque - x_first_opaque + 1;
+    img->x_offset = x_first_opaque;
+    img->original.width = width;
+    img->original.height = height;
+    img->y_offset = y_first_opaque;
+    img->height = y_last_opaque - y_first_opaque + 1;
 
-        pixel_offset += width * font_size->height;
+    if (img->width < 0) {
+        img->width = 0;
+    }
+    if (img->height < 0) {
+        img->height = 0;
     }
-    return pixel_offset;
 }
 
-static int parse_1bit_multibyte_font(buffer *input, color_t *pixels, multibyte_font_sizes *font_size,
-    int letter_spacing, int num_chars, int num_half_width, int offset)
+static void parse_4bit_multibyte_letter(buffer *input, color_t *pixels, const multibyte_font_sizes *font_size,
+    int width, image *img)
 {
-    int pixel_offset = 0;
-    for (int i = 0; i < num_chars; i++) {
-        int width = i < num_half_width ? font_size->half_width : font_size->width;
-        int bytes_per_row = (width - 1) <= 16 ? 2 : 3;
-        color_t *letter = &pixels[pixel_offset];
-        int x_first_opaque = width;
-        int x_last_opaque = -1;
-        int y_first_opaque = font_size->height;
-        int y_last_opaque = -1;
-        for (int row = 0; row < font_size->height; row++) {
-            color_t *pixel = &letter[row * width];
-            unsigned int bits = buffer_read_u16(input);
-            if (bytes_per_row == 3) {
-                bits += buffer_read_u8(input) << 16;
+    int x_first_opaque = width;
+    int x_last_opaque = -1;
+    int y_first_opaque = font_size->height;
+    int y_last_opaque = -1;
+    for (int row = 0; row < font_size->height; row++) {
+        uint8_t bits = 0;
+        for (int col = 0; col < font_size->width - multibyte_font.letter_spacing; col++) {
+            if (col % 2 == 0) {
+                bits = buffer_read_u8(input);
             }
-            int prev_set = 0;
-            for (int col = 0; col < font_size->width - letter_spacing; col++) {
-                int set = bits & 1;
-                if (set || prev_set) {
-                    *pixel = set ? COLOR_WHITE : ALPHA_FONT_SEMI_TRANSPARENT;
+            if (col < width) {
+                uint8_t value = bits & 0xf;
+                if (value != 0) {
+                    if (pixels) {
+                        uint32_t color_value = (value * 16 + value);
+                        pixels[row * width + col] = (color_value << COLOR_BITSHIFT_ALPHA) | COLOR_CHANNEL_RGB;
+                    }
                     if (col < x_first_opaque) {
                         x_first_opaque = col;
                     }
@@ -897,33 +884,201 @@ static int parse_1bit_multibyte_font(buffer *input, color_t *pixels, multibyte_f
                     }
                     y_last_opaque = row;
                 }
-                pixel++;
-                bits >>= 1;
-                prev_set = set;
             }
+            bits >>= 4;
         }
-        image *img = &data.font[offset + i];
-        img->width = x_last_opaque - x_first_opaque + 1;
-        img->x_offset = x_first_opaque;
-        img->original.width = width;
-        img->original.height = font_size->height;
-        img->y_offset = y_first_opaque;
-        img->height = y_last_opaque - y_first_opaque + 1;
-
-        if (img->width < 0) {
-            img->width = 0;
+    }
+    set_multibyte_letter_size(img, width, font_size->height,
+        x_first_opaque, x_last_opaque, y_first_opaque, y_last_opaque);
+}
+
+static void parse_1bit_multibyte_letter(buffer *input, color_t *pixels, const multibyte_font_sizes *font_size,
+    int width, image *img)
+{
+    int bytes_per_row = (width - 1) <= 16 ? 2 : 3;
+    int x_first_opaque = width;
+    int x_last_opaque = -1;
+    int y_first_opaque = font_size->height;
+    int y_last_opaque = -1;
+    for (int row = 0; row < font_size->height; row++) {
+        unsigned int bits = buffer_read_u16(input);
+        if (bytes_per_row == 3) {
+            bits += buffer_read_u8(input) << 16;
         }
-        if (img->height < 0) {
-            img->height = 0;
+        int prev_set = 0;
+        for (int col = 0; col < font_size->width - multibyte_font.letter_spacing; col++) {
+            int set = bits & 1;
+            if (set || prev_set) {
+                if (pixels && col < width) {
+                    pixels[row * width + col] = set ? COLOR_WHITE : ALPHA_FONT_SEMI_TRANSPARENT;
+                }
+                if (col < x_first_opaque) {
+                    x_first_opaque = col;
+                }
+                if (col > x_last_opaque) {
+                    x_last_opaque = col;
+                }
+                if (row < y_first_opaque) {
+                    y_first_opaque = row;
+                }
+                y_last_opaque = row;
+            }
+            bits >>= 1;
+            prev_set = set;
         }
+    }
+    set_multibyte_letter_size(img, width, font_size->height,
+        x_first_opaque, x_last_opaque, y_first_opaque, y_last_opaque);
+}
 
-        image_packer_rect *rect = &data.packer.rects[offset + i];
-        rect->input.width = img->width;
-        rect->input.height = img->height;
+static int multibyte_letter_data_size(const multibyte_font_sizes *font_size, int width)
+{
+    if (multibyte_font.file_version == 2) {
+        return font_size->height * ((font_size->width - multibyte_font.letter_spacing + 1) / 2);
+    } else {
+        return font_size->height * ((width - 1) <= 16 ? 2 : 3);
+    }
+}
 
-        pixel_offset += width * font_size->height;
+static void parse_multibyte_letter(int index, color_t *pixels)
+{
+    int style = index / multibyte_font.num_chars;
+    int char_id = index % multibyte_font.num_chars;
+    const multibyte_font_sizes *font_size = &multibyte_font.sizes[style];
+    int num_half_width = multibyte_font.num_half_width;
+    int half_width_size = multibyte_letter_data_size(font_size, font_size->half_width);
+    int full_width_size = multibyte_letter_data_size(font_size, font_size->width);
+
+    int offset = multibyte_font.style_offsets[style];
+    int width;
+    if (char_id < num_half_width) {
+        offset += char_id * half_width_size;
+        width = font_size->half_width;
+    } else {
+        offset += num_half_width * half_width_size + (char_id - num_half_width) * full_width_size;
+        width = font_size->width;
+    }
+    buffer input;
+    buffer_init(&input, multibyte_font.file_data, multibyte_font.file_size);
+    buffer_set(&input, offset);
+    if (multibyte_font.file_version == 2) {
+        parse_4bit_multibyte_letter(&input, pixels, font_size, width, &data.font[index]);
+    } else {
+        parse_1bit_multibyte_letter(&input, pixels, font_size, width, &data.font[index]);
     }
-    return pixel_offset;
+}
+
+static void move_slot_to_front(int slot)
+{
+    if (slot == multibyte_font.first_slot) {
+        return;
+    }
+    int prev = multibyte_font.slots[slot].prev;
+    int next = multibyte_font.slots[slot].next;
+    multibyte_font.slots[prev].next = next;
+    if (next >= 0) {
+        multibyte_font.slots[next].prev = prev;
+    } else {
+        multibyte_font.last_slot = prev;
+    }
+    multibyte_font.slots[slot].prev = -1;
+    multibyte_font.slots[slot].next = multibyte_font.first_slot;
+    multibyte_font.slots[multibyte_font.first_slot].prev = slot;
+    multibyte_font.first_slot = slot;
+}
+
+static void load_multibyte_letter_into_atlas(int index)
+{
+    // the least recently drawn letter makes place for the new one
+    int slot = multibyte_font.last_slot;
+    int x_offset = (slot % multibyte_font.slots_per_row) * multibyte_font.slot_width;
+    int y_offset = (slot / multibyte_font.slots_per_row) * multibyte_font.slot_height;
+
+    image *img = &data.font[index];
+    if (img->width && img->height) {
+        color_t *pixels = multibyte_font.letter_pixels;
+        memset(pixels, 0, sizeof(color_t) * img->original.width * img->original.height);
+        parse_multibyte_letter(index, pixels);
+        // crop in place, every row moves to a lower or equal position
+        for (int y = 0; y < img->height; y++) {
+            memmove(&pixels[y * img->width], &pixels[(img->y_offset + y) * img->original.width + img->x_offset],
+                img->width * sizeof(color_t));
+        }
+        if (!graphics_renderer()->update_image_atlas(ATLAS_FONT, 0, pixels,
+                x_offset, y_offset, img->width, img->height)) {
+            // the slot keeps its letter and this one is loaded again the next time it is drawn
+            return;
+        }
+    }
+    int previous_letter = multibyte_font.slots[slot].letter;
+    if (previous_letter >= 0) {
+        multibyte_font.letter_slots[previous_letter] = NO_ATLAS_SLOT;
+    }
+    multibyte_font.slots[slot].letter = index;
+    multibyte_font.letter_slots[index] = slot;
+    move_slot_to_front(slot);
+    performance_add(PERFORMANCE_COUNTER_FONT_ATLAS_MISSES, 1);
+
+    img->atlas.id = ATLAS_FONT << IMAGE_ATLAS_BIT_OFFSET;
+    img->atlas.x_offset = x_offset;
+    img->atlas.y_offset = y_offset;
+}
+
+static const image *get_multibyte_letter(int index, int for_drawing)
+{
+    if (index < 0 || index >= FONT_STYLES * multibyte_font.num_chars) {
+        return &DUMMY_IMAGE;
+    }
+    if (!multibyte_font.letter_sizes_known[index]) {
+        parse_multibyte_letter(index, 0);
+        multibyte_font.letter_sizes_known[index] = 1;
+    }
+    if (for_drawing) {
+        int slot = multibyte_font.letter_slots[index];
+        if (slot == NO_ATLAS_SLOT) {
+            load_multibyte_letter_into_atlas(index);
+        } else {
+            move_slot_to_front(slot);
+        }
+    }
+    return &data.font[index];
+}
+
+static void free_multibyte_font(void)
+{
+    free(multibyte_font.file_data);
+    free(multibyte_font.letter_sizes_known);
+    free(multibyte_font.letter_slots);
+    free(multibyte_font.slots);
+    free(multibyte_font.letter_pixels);
+    memset(&multibyte_font, 0, sizeof(multibyte_font));
+}
+
+static int init_multibyte_font_atlas(void)
+{
+    int page_width = calc_bound(MULTIBYTE_FONT_ATLAS_SIZE, multibyte_font.slot_width, data.max_image_width);
+    int page_height = calc_bound(MULTIBYTE_FONT_ATLAS_SIZE, multibyte_font.slot_height, data.max_image_height);
+    multibyte_font.slots_per_row = page_width / multibyte_font.slot_width;
+    multibyte_font.num_slots = multibyte_font.slots_per_row * (page_height / multibyte_font.slot_height);
+
+    multibyte_font.slots = malloc(sizeof(*multibyte_font.slots) * multibyte_font.num_slots);
+    if (!multibyte_font.slots) {
+        return 0;
+    }
+    for (int i = 0; i < multibyte_font.num_slots; i++) {
+        multibyte_font.slots[i].letter = -1;
+        multibyte_font.slots[i].prev = i - 1;
+        multibyte_font.slots[i].next = i + 1 < multibyte_font.num_slots ? i + 1 : -1;
+    }
+    multibyte_font.first_slot = 0;
+    multibyte_font.last_slot = multibyte_font.num_slots - 1;
+
+    const image_atlas_data *atlas_data = graphics_renderer()->prepare_image_atlas(ATLAS_FONT, 1,
+        page_width, page_height);
+    if (!atlas_data) {
+        return 0;
+    }
+    return graphics_renderer()->create_image_atlas(atlas_data, 1);
 }
 
 static int load_multibyte_font(multibyte_font_type type)
@@ -938,7 +1093,7 @@ static int load_multibyte_font(multibyte_font_type type)
         return 0;
     }
 
-    log_info("Parsing multibyte font", font_info->name, 0);
+    log_info("Loading multibyte font", font_info->name, 0);
 
     int file_version = 2;
     int data_size = io_read_file_into_buffer(font_info->file_v2, MAY_BE_LOCALIZED, tmp_data, font_info->data_size);
@@ -954,95 +1109,47 @@ static int load_multibyte_font(multibyte_font_type type)
             return 0;
         }
     }
-
-    buffer input;
-    buffer_init(&input, tmp_data, data_size);
-    int num_chars = font_info->chars;
-    int num_half_width = font_info->half_width_chars;
-    int num_full_width = num_chars - num_half_width;
-
-    if (image_packer_init(&data.packer, entries, data.max_image_width, data.max_image_height) != IMAGE_PACKER_OK) {
-        free_font_memory();
-        free(tmp_data);
-        log_error("Internal error loading font", 0, 0);
-        return 0;
-    }
-    data.packer.options.fail_policy = IMAGE_PACKER_NEW_IMAGE;
-    data.packer.options.reduce_image_size = 1;
-    data.packer.options.sort_by = IMAGE_PACKER_SORT_BY_AREA;
-
-    multibyte_font_sizes *font_sizes;
-    int (*parse_multibyte_font)(buffer * input, color_t * pixels, multibyte_font_sizes * font_size,
-        int letter_spacing, int num_chars, int num_half_width, int offset);
-    if (file_version == 2) {
-        font_sizes = font_info->sizes.v2;
-        parse_multibyte_font = parse_4bit_multibyte_font;
-    } else {
-        font_sizes = font_info->sizes.v1;
-        parse_multibyte_font = parse_1bit_multibyte_font;
-    }
-
-    size_t font_data_size = sizeof(color_t) * (font_sizes[0].width * font_sizes[0].height + font_sizes[1].width * font_sizes[1].height +
-        font_sizes[2].width * font_sizes[2].height) * num_full_width;
-    font_data_size += sizeof(color_t) * (font_sizes[0].half_width * font_sizes[0].height +
-        font_sizes[1].half_width * font_sizes[1].height +
-        font_sizes[2].half_width * font_sizes[2].height) * num_half_width;
-
-    color_t *font_data = malloc(font_data_size);
-    if (!font_data) {
-        image_packer_free(&data.packer);
-        free_font_memory();
-        free(tmp_data);
-        return 0;
-    }
-
-    memset(font_data, 0, font_data_size);
-    color_t *font_offset = font_data;
+    // the letters are read from the file when they are first needed, so the file is kept
+    uint8_t *file_data = realloc(tmp_data, data_size);
+    multibyte_font.file_data = file_data ? file_data : tmp_data;
+    multibyte_font.file_size = data_size;
+    multibyte_font.file_version = file_version;
+    multibyte_font.sizes = file_version == 2 ? font_info->sizes.v2 : font_info->sizes.v1;
+    multibyte_font.letter_spacing = font_info->letter_spacing;
+    multibyte_font.num_chars = font_info->chars;
+    multibyte_font.num_half_width = font_info->half_width_chars;
+
+    int num_full_width = multibyte_font.num_chars - multibyte_font.num_half_width;
+    int style_offset = 0;
     for (int i = 0; i < FONT_STYLES; i++) {
-        font_offset += parse_multibyte_font(&input, font_offset, &font_sizes[i], font_info->letter_spacing,
-            num_chars, num_half_width, num_chars * i);
+        const multibyte_font_sizes *font_size = &multibyte_font.sizes[i];
+        multibyte_font.style_offsets[i] = style_offset;
+        style_offset += multibyte_font.num_half_width * multibyte_letter_data_size(font_size, font_size->half_width);
+        style_offset += num_full_width * multibyte_letter_data_size(font_size, font_size->width);
+        if (font_size->width > multibyte_font.slot_width) {
+            multibyte_font.slot_width = font_size->width;
+        }
+        if (font_size->height > multibyte_font.slot_height) {
+            multibyte_font.slot_height = font_size->height;
+        }
     }
 
-    image_packer_pack(&data.packer);
-    const image_atlas_data *atlas_data = graphics_renderer()->prepare_image_atlas(ATLAS_FONT,
-        data.packer.result.images_needed, data.packer.result.last_image_width, data.packer.result.last_image_height);
-    if (!atlas_data) {
-        free(font_data);
-        image_packer_free(&data.packer);
+    multibyte_font.letter_sizes_known = malloc(sizeof(uint8_t) * entries);
+    multibyte_font.letter_slots = malloc(sizeof(int) * entries);
+    multibyte_font.letter_pixels = malloc(sizeof(color_t) * multibyte_font.slot_width * multibyte_font.slot_height);
+    if (!multibyte_font.letter_sizes_known || !multibyte_font.letter_slots || !multibyte_font.letter_pixels ||
+        !init_multibyte_font_atlas()) {
         free_font_memory();
-        free(tmp_data);
+        log_error("Unable to create the font atlas", font_info->name, 0);
         return 0;
     }
-
-    color_t *letter = font_data;
-    for (int i = 0; i < FONT_STYLES; i++) {
-        int offset = i * num_chars;
-        int original_height = font_sizes[i].height;
-        for (int j = 0; j < num_chars; j++) {
-            image *img = &data.font[offset + j];
-            image_packer_rect *rect = &data.packer.rects[offset + j];
-            img->atlas.id = (ATLAS_FONT << IMAGE_ATLAS_BIT_OFFSET) | rect->output.image_index;
-            img->atlas.x_offset = rect->output.x;
-            img->atlas.y_offset = rect->output.y;
-
-            color_t *dst = atlas_data->buffers[rect->output.image_index];
-            int dst_width = atlas_data->image_widths[rect->output.image_index];
-
-            for (int y = 0; y < img->height; y++) {
-                memcpy(&dst[(img->atlas.y_offset + y) * dst_width + img->atlas.x_offset],
-                    &letter[(img->y_offset + y) * img->original.width + img->x_offset], img->width * sizeof(color_t));
-            }
-            letter += original_height * img->original.width;
-        }
+    memset(multibyte_font.letter_sizes_known, 0, sizeof(uint8_t) * entries);
+    for (int i = 0; i < entries; i++) {
+        multibyte_font.letter_slots[i] = NO_ATLAS_SLOT;
     }
 
-    graphics_renderer()->create_image_atlas(atlas_data, 1);
+    log_info("Done loading font", font_info->name, 0);
 
-    log_info("Done parsing font", font_info->name, 0);
-
-    image_packer_free(&data.packer);
-    free(font_data);
-    free(tmp_data);
     data.fonts_enabled = MULTIBYTE_IN_FONT;
     data.font_base_offset = 0;
     return 1;
@@ -1333,7 +1440,7 @@ const image *image_letter(int letter_id)
     if (data.fonts_enabled == FULL_CHARSET_IN_FONT) {
         return &data.font[data.font_base_offset + letter_id];
     } else if (data.fonts_enabled == MULTIBYTE_IN_FONT && letter_id >= IMAGE_FONT_MULTIBYTE_OFFSET) {
-        return &data.font[data.font_base_offset + letter_id - IMAGE_FONT_MULTIBYTE_OFFSET];
+        return get_multibyte_letter(letter_id - IMAGE_FONT_MULTIBYTE_OFFSET, 0);
     } else if (letter_id < IMAGE_FONT_MULTIBYTE_OFFSET) {
         return &data.main[data.group_image_ids[GROUP_FONT] + letter_id];
     } else {
@@ -1341,6 +1448,14 @@ const image *image_letter(int letter_id)
     }
 }
 
+const image *image_letter_for_drawing(int letter_id)
+{
+    if (data.fonts_enabled == MULTIBYTE_IN_FONT && letter_id >= IMAGE_FONT_MULTIBYTE_OFFSET) {
+        return get_multibyte_letter(letter_id - IMAGE_FONT_MULTIBYTE_OFFSET, 1);
+    }
+    return image_letter(letter_id);
+}
+
 const image *image_get_enemy(int id)
 {
     if (id >= 0 && id < ENEMY_ENTRIES) {
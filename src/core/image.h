@@ -168,6 +168,13 @@ const image *image_get(int id);
  */
 const image *image_letter(int letter_id);
 
+/**
+ * Gets a letter image like image_letter, making sure the letter is in the font atlas so it can be drawn
+ * @param letter_id Letter offset
+ * @return Image
+ */
+const image *image_letter_for_drawing(int letter_id);
+
 /**
  * Gets an enemy image by id
  * @param id Enemy image ID
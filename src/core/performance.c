@@ -0,0 +1,202 @@
+#include "performance.h"
+
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "game/system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_RECORDED_FRAMES 3600
+#define STATISTICS_FRAMES 120
+
+typedef struct {
+    int frame_time;
+    int phase_time[PERFORMANCE_PHASE_MAX];
+    int counters[PERFORMANCE_COUNTER_MAX];
+} frame_sample;
+
+static const char *PHASE_NAMES[PERFORMANCE_PHASE_MAX] = {
+    "input_us", "run_us", "draw_us", "sound_us", "render_us"
+};
+
+static const char *COUNTER_NAMES[PERFORMANCE_COUNTER_MAX] = {
+    "ticks", "ticks_due", "draw_calls", "texture_switches", "figures", "routes", "font_atlas_misses"
+};
+
+static struct {
+    int enabled;
+    int in_frame;
+    frame_sample current;
+    uint64_t frame_start;
+    uint64_t phase_start[PERFORMANCE_PHASE_MAX];
+    // ring buffer of the recorded frames, oldest first starting at first_frame
+    frame_sample *frames;
+    int first_frame;
+    int num_frames;
+    int first_frame_number;
+} data;
+
+int performance_is_enabled(void)
+{
+    return data.enabled;
+}
+
+void performance_set_enabled(int enabled)
+{
+    if (enabled && !data.frames) {
+        data.frames = malloc(sizeof(frame_sample) * MAX_RECORDED_FRAMES);
+        if (!data.frames) {
+            log_error("Unable to allocate memory for the performance overlay", 0, 0);
+            return;
+        }
+    }
+    if (enabled && !data.enabled) {
+        data.first_frame = 0;
+        data.num_frames = 0;
+        data.first_frame_number = 0;
+    }
+    data.enabled = enabled;
+    data.in_frame = 0;
+}
+
+void performance_start_frame(void)
+{
+    memset(&data.current, 0, sizeof(frame_sample));
+    data.in_frame = data.enabled;
+    if (data.in_frame) {
+        data.frame_start = system_get_microseconds();
+    }
+}
+
+void performance_end_frame(void)
+{
+    if (!data.in_frame) {
+        return;
+    }
+    data.in_frame = 0;
+    data.current.frame_time = (int) (system_get_microseconds() - data.frame_start);
+    if (data.num_frames < MAX_RECORDED_FRAMES) {
+        data.frames[(data.first_frame + data.num_frames) % MAX_RECORDED_FRAMES] = data.current;
+        data.num_frames++;
+    } else {
+        data.frames[data.first_frame] = data.current;
+        data.first_frame = (data.first_frame + 1) % MAX_RECORDED_FRAMES;
+        data.first_frame_number++;
+    }
+}
+
+void performance_start_phase(performance_phase phase)
+{
+    if (data.in_frame) {
+        data.phase_start[phase] = system_get_microseconds();
+    }
+}
+
+void performance_end_phase(performance_phase phase)
+{
+    if (data.in_frame) {
+        data.current.phase_time[phase] += (int) (system_get_microseconds() - data.phase_start[phase]);
+    }
+}
+
+void performance_add(performance_counter counter, int amount)
+{
+    data.current.counters[counter] += amount;
+}
+
+void performance_set(performance_counter counter, int value)
+{
+    data.current.counters[counter] = value;
+}
+
+static const frame_sample *get_frame(int index)
+{
+    return &data.frames[(data.first_frame + index) % MAX_RECORDED_FRAMES];
+}
+
+static int compare_ints(const void *a, const void *b)
+{
+    int va = *(const int *) a;
+    int vb = *(const int *) b;
+    return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+void performance_get_statistics(performance_statistics *stats)
+{
+    memset(stats, 0, sizeof(performance_statistics));
+    if (!data.frames || !data.num_frames) {
+        return;
+    }
+    int first = data.num_frames > STATISTICS_FRAMES ? data.num_frames - STATISTICS_FRAMES : 0;
+    int frame_times[STATISTICS_FRAMES];
+    stats->num_frames = data.num_frames - first;
+    for (int i = 0; i < stats->num_frames; i++) {
+        const frame_sample *frame = get_frame(first + i);
+        frame_times[i] = frame->frame_time;
+        for (int p = 0; p < PERFORMANCE_PHASE_MAX; p++) {
+            stats->phase_time[p] += frame->phase_time[p];
+        }
+        for (int c = 0; c < PERFORMANCE_COUNTER_MAX; c++) {
+            stats->counters_total[c] += frame->counters[c];
+        }
+    }
+    for (int p = 0; p < PERFORMANCE_PHASE_MAX; p++) {
+        stats->phase_time[p] /= stats->num_frames;
+    }
+    memcpy(stats->counters_last, get_frame(data.num_frames - 1)->counters, sizeof(stats->counters_last));
+
+    qsort(frame_times, stats->num_frames, sizeof(int), compare_ints);
+    stats->frame_time_median = frame_times[(stats->num_frames - 1) * 50 / 100];
+    stats->frame_time_95th = frame_times[(stats->num_frames - 1) * 95 / 100];
+    stats->frame_time_99th = frame_times[(stats->num_frames - 1) * 99 / 100];
+    stats->frame_time_max = frame_times[stats->num_frames - 1];
+}
+
+static const char *generate_filename(void)
+{
+    char filename[FILE_NAME_MAX];
+    time_t curtime = time(NULL);
+    struct tm *loctime = localtime(&curtime);
+    strftime(filename, FILE_NAME_MAX, "performance %Y-%m-%d %H.%M.%S.csv", loctime);
+    return dir_append_location(filename, PATH_LOCATION_SCREENSHOT);
+}
+
+int performance_save_trace(void)
+{
+    if (!data.frames || !data.num_frames) {
+        log_info("No frames recorded, show the performance overlay first", 0, 0);
+        return 0;
+    }
+    const char *filename = generate_filename();
+    FILE *fp = file_open(filename, "w");
+    if (!fp) {
+        log_error("Unable to write performance trace to:", filename, 0);
+        return 0;
+    }
+    fprintf(fp, "frame,frame_us");
+    for (int p = 0; p < PERFORMANCE_PHASE_MAX; p++) {
+        fprintf(fp, ",%s", PHASE_NAMES[p]);
+    }
+    for (int c = 0; c < PERFORMANCE_COUNTER_MAX; c++) {
+        fprintf(fp, ",%s", COUNTER_NAMES[c]);
+    }
+    fprintf(fp, "\n");
+    for (int i = 0; i < data.num_frames; i++) {
+        const frame_sample *frame = get_frame(i);
+        fprintf(fp, "%d,%d", data.first_frame_number + i, frame->frame_time);
+        for (int p = 0; p < PERFORMANCE_PHASE_MAX; p++) {
+            fprintf(fp, ",%d", frame->phase_time[p]);
+        }
+        for (int c = 0; c < PERFORMANCE_COUNTER_MAX; c++) {
+            fprintf(fp, ",%d", frame->counters[c]);
+        }
+        fprintf(fp, "\n");
+    }
+    file_close(fp);
+    log_info("Saved performance trace:", filename, data.num_frames);
+    return 1;
+}
@@ -0,0 +1,100 @@
+#ifndef CORE_PERFORMANCE_H
+#define CORE_PERFORMANCE_H
+
+/**
+ * @file
+ * Frame time measurements and counters, shown by the performance overlay
+ */
+
+typedef enum {
+    PERFORMANCE_PHASE_INPUT = 0,
+    PERFORMANCE_PHASE_RUN = 1,
+    PERFORMANCE_PHASE_DRAW = 2,
+    PERFORMANCE_PHASE_SOUND = 3,
+    PERFORMANCE_PHASE_RENDER = 4,
+    PERFORMANCE_PHASE_MAX
+} performance_phase;
+
+typedef enum {
+    PERFORMANCE_COUNTER_TICKS = 0,
+    PERFORMANCE_COUNTER_TICKS_DUE = 1,
+    PERFORMANCE_COUNTER_DRAW_CALLS = 2,
+    PERFORMANCE_COUNTER_TEXTURE_SWITCHES = 3,
+    PERFORMANCE_COUNTER_FIGURES = 4,
+    PERFORMANCE_COUNTER_ROUTES = 5,
+    PERFORMANCE_COUNTER_FONT_ATLAS_MISSES = 6,
+    PERFORMANCE_COUNTER_MAX
+} performance_counter;
+
+typedef struct {
+    int num_frames;
+    int frame_time_median;
+    int frame_time_95th;
+    int frame_time_99th;
+    int frame_time_max;
+    int phase_time[PERFORMANCE_PHASE_MAX];
+    int counters_total[PERFORMANCE_COUNTER_MAX];
+    int counters_last[PERFORMANCE_COUNTER_MAX];
+} performance_statistics;
+
+/**
+ * Checks whether frames are being measured
+ * @return 1 if the performance overlay is shown, 0 otherwise
+ */
+int performance_is_enabled(void);
+
+/**
+ * Starts or stops measuring frames. Starting clears the frames recorded before.
+ * @param enabled Whether to measure frames
+ */
+void performance_set_enabled(int enabled);
+
+/**
+ * Starts measuring a frame
+ */
+void performance_start_frame(void);
+
+/**
+ * Records the frame started with performance_start_frame
+ */
+void performance_end_frame(void);
+
+/**
+ * Starts measuring a phase of the current frame
+ * @param phase Phase to measure
+ */
+void performance_start_phase(performance_phase phase);
+
+/**
+ * Adds the time since performance_start_phase to the phase
+ * @param phase Phase to stop measuring
+ */
+void performance_end_phase(performance_phase phase);
+
+/**
+ * Adds to a counter of the current frame
+ * @param counter Counter to add to
+ * @param amount Amount to add
+ */
+void performance_add(performance_counter counter, int amount);
+
+/**
+ * Sets a counter of the current frame
+ * @param counter Counter to set
+ * @param value Value to set
+ */
+void performance_set(performance_counter counter, int value);
+
+/**
+ * Gets the frame time percentiles, average phase times in microseconds and counters of the latest frames
+ * @param stats Statistics to fill
+ */
+void performance_get_statistics(performance_statistics *stats);
+
+/**
+ * Writes all recorded frames as CSV to the screenshot directory
+ * @return 1 if the file was written, 0 otherwise
+ */
+int performance_save_trace(void);
+
+#endif // CORE_PERFORMANCE_H
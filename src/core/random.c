@@ -88,6 +88,10 @@ void random_load_state(buffer *buf)
 {
     data.iv1 = buffer_read_u32(buf);
     data.iv2 = buffer_read_u32(buf);
+    data.random1_7bit = data.iv1 & 0x7f;
+    data.random1_15bit = data.iv1 & 0x7fff;
+    data.random2_7bit = data.iv2 & 0x7f;
+    data.random2_15bit = data.iv2 & 0x7fff;
 }
 
 void random_save_state(buffer *buf)
@@ -96,6 +100,31 @@ void random_save_state(buffer *buf)
     buffer_write_u32(buf, data.iv2);
 }
 
+void random_clear_pool(void)
+{
+    data.pool_index = 0;
+    memset(data.pool, 0, sizeof(data.pool));
+}
+
+void random_load_pool_state(buffer *buf)
+{
+    data.pool_index = buffer_read_i32(buf);
+    for (int i = 0; i < MAX_RANDOM; i++) {
+        data.pool[i] = buffer_read_i32(buf);
+    }
+    if (data.pool_index < 0 || data.pool_index >= MAX_RANDOM) {
+        data.pool_index = 0;
+    }
+}
+
+void random_save_pool_state(buffer *buf)
+{
+    buffer_write_i32(buf, data.pool_index);
+    for (int i = 0; i < MAX_RANDOM; i++) {
+        buffer_write_i32(buf, data.pool[i]);
+    }
+}
+
 int random_from_stdlib(void) {
     time_t t;
     t = time(&t);
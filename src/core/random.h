@@ -68,6 +68,23 @@ void random_save_state(buffer *buf);
  */
 void random_load_state(buffer *buf);
 
+/**
+ * Clears the pool of random bytes, for games saved without it
+ */
+void random_clear_pool(void);
+
+/**
+ * Save the pool of random bytes to buffer
+ * @param buf Buffer to save to
+ */
+void random_save_pool_state(buffer *buf);
+
+/**
+ * Load the pool of random bytes from buffer
+ * @param buf Buffer to read from
+ */
+void random_load_pool_state(buffer *buf);
+
 int random_from_stdlib(void);
 
 int random_between_from_stdlib(int min, int max);
@@ -51,3 +51,8 @@ int zlib_helper_compress(void *input_buffer, const int input_length, void *outpu
     *output_length = output_buffer_length - strm.avail_out;
     return 1;
 }
+
+int zlib_helper_compress_bound(const int input_length)
+{
+    return (int) mz_compressBound(input_length);
+}
@@ -5,4 +5,10 @@ int zlib_helper_decompress(void *input_buffer, const int input_length, void *out
 
 int zlib_helper_compress(void *input_buffer, const int input_length, void *output_buffer, const int output_buffer_length, int *output_length);
 
+/**
+ * Returns the maximum size the compressed data can have
+ * @param input_length Length of the uncompressed data
+ */
+int zlib_helper_compress_bound(const int input_length);
+
 #endif // CORE_ZLIB_HELPER_H
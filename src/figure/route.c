@@ -5,6 +5,9 @@
 #include "map/routing.h"
 #include "map/routing_path.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #define ARRAY_SIZE_STEP 600
 #define MAX_PATH_LENGTH 500
 
@@ -172,6 +175,8 @@ void figure_route_save_state(buffer *figures, buffer *buf_paths)
 {
     int size = paths.size * sizeof(int);
     uint8_t *buf_data = malloc(size);
+    // the figure ids only fill half of the buffer, clear the rest so saves of the same game are identical
+    memset(buf_data, 0, size);
     buffer_init(figures, buf_data, size);
 
     size = paths.size * sizeof(uint8_t) * MAX_PATH_LENGTH;
@@ -21,19 +21,13 @@
 static int provide_culture(int x, int y, void (*callback)(building *))
 {
     int serviced = 0;
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(x, y, 1, 2, &x_min, &y_min, &x_max, &y_max);
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
-            if (building_id) {
-                building *b = building_get(building_id);
-                if (b->house_size && b->house_population > 0) {
-                    callback(b);
-                    serviced++;
-                }
-            }
+    const uint16_t *houses;
+    int num_houses = map_building_houses_in_service_area(x, y, &houses);
+    for (int i = 0; i < num_houses; i++) {
+        building *b = building_get(houses[i]);
+        if (b->house_size && b->house_population > 0) {
+            callback(b);
+            serviced++;
         }
     }
     return serviced;
@@ -62,19 +56,13 @@ static void provide_sickness(int x, int y, void (*callback)(building *, int sick
 static int provide_entertainment(int x, int y, int shows, void (*callback)(building *, int))
 {
     int serviced = 0;
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(x, y, 1, 2, &x_min, &y_min, &x_max, &y_max);
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
-            if (building_id) {
-                building *b = building_get(building_id);
-                if (b->house_size && b->house_population > 0) {
-                    callback(b, shows);
-                    serviced++;
-                }
-            }
+    const uint16_t *houses;
+    int num_houses = map_building_houses_in_service_area(x, y, &houses);
+    for (int i = 0; i < num_houses; i++) {
+        building *b = building_get(houses[i]);
+        if (b->house_size && b->house_population > 0) {
+            callback(b, shows);
+            serviced++;
         }
     }
     return serviced;
@@ -427,20 +415,13 @@ static int provide_market_goods(int market_building_id, int x, int y)
 {
     int serviced = 0;
     building *market = building_get(market_building_id);
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(x, y, 1, 2, &x_min, &y_min, &x_max, &y_max);
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
-            if (building_id) {
-                building *b = building_get(building_id);
-                if (b->house_size && b->house_population > 0) {
-                    distribute_market_resources(b, market);
-                    serviced++;
-                }
-
-            }
+    const uint16_t *houses;
+    int num_houses = map_building_houses_in_service_area(x, y, &houses);
+    for (int i = 0; i < num_houses; i++) {
+        building *b = building_get(houses[i]);
+        if (b->house_size && b->house_population > 0) {
+            distribute_market_resources(b, market);
+            serviced++;
         }
     }
     return serviced;
@@ -481,19 +462,13 @@ static int collect_offerings(int market_building_id, int x, int y)
 {
     int serviced = 0;
     building *market = building_get(market_building_id);
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(x, y, 1, 2, &x_min, &y_min, &x_max, &y_max);
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
-            if (building_id) {
-                building *b = building_get(building_id);
-                if (b->house_size && b->house_population > 0) {
-                    collect_offerings_from_house(b, market);
-                    serviced++;
-                }
-            }
+    const uint16_t *houses;
+    int num_houses = map_building_houses_in_service_area(x, y, &houses);
+    for (int i = 0; i < num_houses; i++) {
+        building *b = building_get(houses[i]);
+        if (b->house_size && b->house_population > 0) {
+            collect_offerings_from_house(b, market);
+            serviced++;
         }
     }
     return serviced;
@@ -35,8 +35,10 @@
 #include "game/campaign.h"
 #include "game/difficulty.h"
 #include "game/file_io.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/state.h"
+#include "game/tick.h"
 #include "game/time.h"
 #include "game/tutorial.h"
 #include "game/undo.h"
@@ -103,6 +105,7 @@ static void clear_scenario_data(void)
     city_message_init_scenario();
     game_state_init();
     game_animation_init();
+    game_tick_reset();
     sound_city_init();
     building_menu_enable_all();
     building_clear_all();
@@ -338,6 +341,7 @@ static int start_scenario(const uint8_t *scenario_name, const char *scenario_fil
     }
     building_menu_update();
     city_message_init_scenario();
+    game_replay_start_recording();
 
     return 1;
 }
@@ -410,6 +414,7 @@ int game_file_start_scenario_from_buffer(uint8_t *data, int length, int is_save_
     }
     building_menu_update();
     city_message_init_scenario();
+    game_replay_start_recording();
 
     return 1;
 }
@@ -444,6 +449,7 @@ int game_file_load_saved_game(const char *filename)
     building_storage_reset_building_ids();
 
     sound_music_update(1);
+    game_replay_start_recording();
     return 1;
 }
 
@@ -452,6 +458,17 @@ int game_file_write_saved_game(const char *filename)
     return game_file_io_write_saved_game(filename);
 }
 
+int game_file_write_autosave(const char *filename)
+{
+    return game_file_io_write_autosave(filename);
+}
+
+int game_file_write_delta_saved_game(const char *filename, const char *checkpoint_filename,
+    const char *alternate_checkpoint_filename)
+{
+    return game_file_io_write_delta_saved_game(filename, checkpoint_filename, alternate_checkpoint_filename);
+}
+
 int game_file_delete_saved_game(const char *filename)
 {
     return game_file_io_delete_saved_game(filename);
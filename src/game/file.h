@@ -41,6 +41,23 @@ int game_file_load_saved_game(const char *filename);
  */
 int game_file_write_saved_game(const char *filename);
 
+/**
+ * Write an autosave to disk, without the minimap thumbnail of the file dialog
+ * @param filename File to save to
+ * @return Boolean true on success, false on failure
+ */
+int game_file_write_autosave(const char *filename);
+
+/**
+ * Write saved game to disk, storing only what changed since the last full checkpoint
+ * @param filename File to save to
+ * @param checkpoint_filename File to write the full checkpoint to when needed
+ * @param alternate_checkpoint_filename File to write the checkpoint to while the other one is still in use
+ * @return Boolean true on success, false on failure
+ */
+int game_file_write_delta_saved_game(const char *filename, const char *checkpoint_filename,
+    const char *alternate_checkpoint_filename);
+
 /**
  * Delete saved game
  * @param filename File to delete
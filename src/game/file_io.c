@@ -2,6 +2,7 @@
 
 #include "building/barracks.h"
 #include "building/count.h"
+#include "building/figure.h"
 #include "building/granary.h"
 #include "building/list.h"
 #include "building/monument.h"
@@ -10,6 +11,7 @@
 #include "city/data.h"
 #include "city/message.h"
 #include "city/view.h"
+#include "core/delta_rle.h"
 #include "core/dir.h"
 #include "core/file.h"
 #include "core/log.h"
@@ -31,6 +33,8 @@
 #include "figure/visited_buildings.h"
 #include "game/file.h"
 #include "game/save_version.h"
+#include "game/system.h"
+#include "game/tick.h"
 #include "game/time.h"
 #include "game/tutorial.h"
 #include "map/aqueduct.h"
@@ -39,6 +43,7 @@
 #include "map/desirability.h"
 #include "map/elevation.h"
 #include "map/figure.h"
+#include "map/grid.h"
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
@@ -73,13 +78,39 @@
 #define COMPRESS_BUFFER_INITIAL_SIZE 1000000
 #define UNCOMPRESSED 0x80000000
 #define PIECE_SIZE_DYNAMIC 0
+// pieces that delta-RLE shrinks to this fraction of their size skip zlib, as they decode much faster
+#define DELTA_RLE_MAX_RATIO 8
+// a delta save refers to a full checkpoint that is rewritten after this many delta saves
+#define DELTA_SAVES_PER_CHECKPOINT 12
+#define CHECKPOINT_PIECE_SIZE (2 * sizeof(int32_t))
+// 33x 4-byte values plus the scenario name, campaign name and description
+#define FILE_INFO_HEADER_SIZE (33 * sizeof(int32_t) + MAX_SCENARIO_NAME + FILE_NAME_MAX + MAX_BRIEF_DESCRIPTION)
+
+typedef enum {
+    PIECE_CODEC_NONE = 0,
+    PIECE_CODEC_ZLIB = 1,
+    PIECE_CODEC_DELTA_RLE = 2,
+    // the piece has not changed since the checkpoint the delta save refers to
+    PIECE_CODEC_CHECKPOINT = 3,
+    // never written: old saves use zip for all compressed pieces
+    PIECE_CODEC_ZIP = 0x100
+} piece_codec;
 
 typedef struct {
     buffer buf;
     int compressed;
     int dynamic;
+    int mapped;
+    int filtered_grid;
+    int from_checkpoint;
 } file_piece;
 
+typedef enum {
+    SAVE_TYPE_FULL = 0,
+    SAVE_TYPE_CHECKPOINT = 1,
+    SAVE_TYPE_DELTA = 2
+} save_type;
+
 typedef struct {
     buffer *resource_version;
     buffer *graphic_ids;
@@ -121,6 +152,9 @@ typedef struct {
     buffer *scenario_campaign_mission;
     buffer *file_version;
     buffer *scenario_version;
+    buffer *file_info;
+    buffer *minimap;
+    buffer *checkpoint;
     buffer *image_grid;
     buffer *edge_grid;
     buffer *building_grid;
@@ -220,6 +254,10 @@ typedef struct {
     buffer *deliveries;
     buffer *custom_empire;
     buffer *visited_buildings;
+    buffer *random_pool;
+    buffer *beggar_counter;
+    buffer *sliced_passes;
+    buffer *desirability_update;
 } savegame_state;
 
 typedef struct {
@@ -274,15 +312,54 @@ typedef struct {
         int visited_buildings;
         int custom_campaigns;
         int dynamic_scenario_objects;
+        int file_info_header;
+        int filtered_grids;
+        int delta_saves;
+        int random_pool;
+        int sliced_passes;
     } features;
 } savegame_version_data;
 
 static struct {
     int num_pieces;
+    int num_info_pieces;
     file_piece pieces[sizeof(savegame_state) / sizeof(buffer *) + 1];
     savegame_state state;
 } savegame_data;
 
+// in the same order as the pieces in savegame_state
+static const char *SAVEGAME_PIECE_NAMES[] = {
+    "resource_version", "scenario_campaign_mission", "file_version", "scenario_version", "file_info", "minimap",
+    "checkpoint", "image_grid", "edge_grid", "building_grid", "terrain_grid", "aqueduct_grid",
+    "figure_grid", "bitfields_grid", "sprite_grid", "random_grid", "desirability_grid", "elevation_grid",
+    "building_damage_grid", "aqueduct_backup_grid", "sprite_backup_grid", "figures", "route_figures", "route_paths",
+    "formations", "formation_totals", "city_data", "city_faction_unknown", "player_name", "city_faction", "buildings",
+    "city_view_orientation", "game_time", "building_extra_highest_id_ever", "random_iv", "city_view_camera",
+    "building_count_culture1", "city_graph_order", "emperor_change_time", "empire", "empire_map", "empire_cities",
+    "building_count_industry", "trade_prices", "figure_names", "culture_coverage", "scenario", "scenario_events",
+    "scenario_conditions", "scenario_actions", "custom_messages", "custom_media", "requests", "invasions",
+    "demand_changes", "price_changes", "allowed_buildings", "custom_variables", "message_media_text_blob",
+    "message_media_metadata", "max_game_year", "earthquake", "emperor_change_state", "messages", "message_extra",
+    "population_messages", "message_counts", "message_delays", "building_list_burning_totals", "figure_sequence",
+    "scenario_settings", "invasion_warnings", "scenario_is_custom", "city_sounds", "building_extra_highest_id",
+    "figure_traders", "building_list_burning", "building_list_small", "building_list_large", "tutorial_part1",
+    "building_count_military", "enemy_army_totals", "building_storages", "building_count_culture2",
+    "building_count_support", "tutorial_part2", "gladiator_revolt", "trade_route_limit", "trade_route_traded",
+    "building_barracks_tower_sentry", "building_extra_sequence", "routing_counters", "building_count_culture3",
+    "enemy_armies", "city_entry_exit_xy", "last_invasion_id", "building_extra_corrupt_houses", "scenario_name",
+    "bookmarks", "tutorial_part3", "city_entry_exit_grid_offset", "campaign_name", "end_marker", "deliveries",
+    "custom_empire", "visited_buildings", "random_pool", "beggar_counter", "sliced_passes",
+    "desirability_update"
+};
+
+static struct {
+    int id;
+    char filename[FILE_NAME_MAX];
+    int delta_saves;
+    size_t piece_sizes[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    uint64_t piece_hashes[sizeof(savegame_state) / sizeof(buffer *) + 1];
+} checkpoint_data;
+
 static struct {
     minimap_functions functions;
     savegame_version_t version;
@@ -296,6 +373,9 @@ static void init_file_piece(file_piece *piece, int size, int compressed)
 {
     piece->compressed = compressed;
     piece->dynamic = size == PIECE_SIZE_DYNAMIC;
+    piece->mapped = 0;
+    piece->filtered_grid = 0;
+    piece->from_checkpoint = 0;
     if (piece->dynamic) {
         buffer_init(&piece->buf, 0, 0);
     } else {
@@ -319,14 +399,26 @@ static buffer *create_savegame_piece(int size, int compressed)
     return &piece->buf;
 }
 
+static buffer *create_savegame_grid_piece(int size, int filtered)
+{
+    file_piece *piece = &savegame_data.pieces[savegame_data.num_pieces++];
+    init_file_piece(piece, size, 1);
+    piece->filtered_grid = filtered;
+    return &piece->buf;
+}
+
 static void clear_savegame_pieces(void)
 {
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         buffer_reset(&savegame_data.pieces[i].buf);
-        free(savegame_data.pieces[i].buf.data);
+        if (!savegame_data.pieces[i].mapped) {
+            free(savegame_data.pieces[i].buf.data);
+        }
         savegame_data.pieces[i].buf.data = 0;
+        savegame_data.pieces[i].mapped = 0;
     }
     savegame_data.num_pieces = 0;
+    savegame_data.num_info_pieces = 0;
 }
 
 static void clear_scenario_pieces(void)
@@ -498,6 +590,11 @@ static void get_version_data(savegame_version_data *version_data, savegame_versi
     version_data->features.visited_buildings = version > SAVE_GAME_LAST_GLOBAL_BUILDING_INFO;
     version_data->features.custom_campaigns = version > SAVE_GAME_LAST_NO_CUSTOM_CAMPAIGNS;
     version_data->features.dynamic_scenario_objects = version > SAVE_GAME_LAST_STATIC_SCENARIO_ORIGINAL_DATA;
+    version_data->features.file_info_header = version > SAVE_GAME_LAST_NO_FILE_INFO_HEADER;
+    version_data->features.filtered_grids = version > SAVE_GAME_LAST_UNFILTERED_GRIDS;
+    version_data->features.delta_saves = version > SAVE_GAME_LAST_NO_DELTA_SAVES;
+    version_data->features.random_pool = version > SAVE_GAME_LAST_NO_RANDOM_POOL;
+    version_data->features.sliced_passes = version > SAVE_GAME_LAST_NO_SLICED_PASSES;
 }
 
 static void init_savegame_data(savegame_version_t version)
@@ -516,22 +613,34 @@ static void init_savegame_data(savegame_version_t version)
     if (version_data.features.scenario_version) {
         state->scenario_version = create_savegame_piece(4, 0);
     }
+    if (version_data.features.file_info_header) {
+        state->file_info = create_savegame_piece(PIECE_SIZE_DYNAMIC, 0);
+        state->minimap = create_savegame_piece(PIECE_SIZE_DYNAMIC, 1);
+        // the file dialog only needs the pieces up to here
+        savegame_data.num_info_pieces = savegame_data.num_pieces;
+    }
+    if (version_data.features.delta_saves) {
+        state->checkpoint = create_savegame_piece(PIECE_SIZE_DYNAMIC, 0);
+    } else {
+        state->checkpoint = 0;
+    }
+    int filter_grids = version_data.features.filtered_grids;
     if (version_data.features.image_grid) {
-        state->image_grid = create_savegame_piece(version_data.piece_sizes.image_grid, 1);
-    }
-    state->edge_grid = create_savegame_piece(26244, 1);
-    state->building_grid = create_savegame_piece(52488, 1);
-    state->terrain_grid = create_savegame_piece(version_data.piece_sizes.terrain_grid, 1);
-    state->aqueduct_grid = create_savegame_piece(26244, 1);
-    state->figure_grid = create_savegame_piece(52488, 1);
-    state->bitfields_grid = create_savegame_piece(26244, 1);
-    state->sprite_grid = create_savegame_piece(26244, 1);
+        state->image_grid = create_savegame_grid_piece(version_data.piece_sizes.image_grid, filter_grids);
+    }
+    state->edge_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->building_grid = create_savegame_grid_piece(52488, filter_grids);
+    state->terrain_grid = create_savegame_grid_piece(version_data.piece_sizes.terrain_grid, filter_grids);
+    state->aqueduct_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->figure_grid = create_savegame_grid_piece(52488, filter_grids);
+    state->bitfields_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->sprite_grid = create_savegame_grid_piece(26244, filter_grids);
     state->random_grid = create_savegame_piece(26244, 0);
-    state->desirability_grid = create_savegame_piece(26244, 1);
-    state->elevation_grid = create_savegame_piece(26244, 1);
-    state->building_damage_grid = create_savegame_piece(26244, 1);
-    state->aqueduct_backup_grid = create_savegame_piece(26244, 1);
-    state->sprite_backup_grid = create_savegame_piece(26244, 1);
+    state->desirability_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->elevation_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->building_damage_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->aqueduct_backup_grid = create_savegame_grid_piece(26244, filter_grids);
+    state->sprite_backup_grid = create_savegame_grid_piece(26244, filter_grids);
     state->figures = create_savegame_piece(version_data.piece_sizes.figures, 1);
     state->route_figures = create_savegame_piece(version_data.piece_sizes.route_figures, 1);
     state->route_paths = create_savegame_piece(version_data.piece_sizes.route_paths, 1);
@@ -655,6 +764,14 @@ static void init_savegame_data(savegame_version_t version)
     if (version_data.features.visited_buildings) {
         state->visited_buildings = create_savegame_piece(PIECE_SIZE_DYNAMIC, 1);
     }
+    if (version_data.features.random_pool) {
+        state->random_pool = create_savegame_piece(404, 0);
+        state->beggar_counter = create_savegame_piece(4, 0);
+    }
+    if (version_data.features.sliced_passes) {
+        state->sliced_passes = create_savegame_piece(12, 0);
+        state->desirability_update = create_savegame_piece(26248, 1);
+    }
 }
 
 static void scenario_load_from_state(scenario_state *file, scenario_version_t version)
@@ -867,6 +984,18 @@ static void savegame_load_from_state(savegame_state *state, savegame_version_t v
     } else {
         figure_visited_buildings_load_state(state->visited_buildings);
     }
+    if (version > SAVE_GAME_LAST_NO_RANDOM_POOL) {
+        random_load_pool_state(state->random_pool);
+        building_figure_load_state(state->beggar_counter);
+    } else {
+        random_clear_pool();
+        building_figure_clear_state();
+    }
+    if (version > SAVE_GAME_LAST_NO_SLICED_PASSES) {
+        game_tick_load_state(state->sliced_passes, state->desirability_update);
+    } else {
+        game_tick_reset();
+    }
 }
 
 static void savegame_save_to_state(savegame_state *state)
@@ -955,6 +1084,9 @@ static void savegame_save_to_state(savegame_state *state)
     building_monument_delivery_save_state(state->deliveries);
     empire_object_save(state->custom_empire);
     figure_visited_buildings_save_state(state->visited_buildings);
+    random_save_pool_state(state->random_pool);
+    building_figure_save_state(state->beggar_counter);
+    game_tick_save_state(state->sliced_passes, state->desirability_update);
 }
 
 static int get_scenario_version(FILE *fp)
@@ -1047,13 +1179,6 @@ static int read_compressed_chunk(FILE *fp, void *dst, size_t bytes_to_read, int
     }
 }
 
-static int read_compressed_savegame_chunk(FILE *fp, void *buf, size_t bytes_to_read,
-    savegame_version_t version, memory_block *compress_buffer)
-{
-    int read_as_zlib = version > SAVE_GAME_LAST_ZIP_COMPRESSION;
-    return read_compressed_chunk(fp, buf, bytes_to_read, read_as_zlib, compress_buffer);
-}
-
 static int write_compressed_chunk(FILE *fp, void *buf, size_t bytes_to_write, memory_block *compress_buffer)
 {
     if (!core_memory_block_ensure_size(compress_buffer, bytes_to_write)) {
@@ -1368,46 +1493,198 @@ int game_file_io_write_scenario(const char *filename)
     return 1;
 }
 
-static int savegame_read_from_buffer(buffer *buf, savegame_version_t version)
+typedef struct {
+    int piece_index;
+    uint8_t *input;
+    int input_size;
+    int owns_input;
+    piece_codec codec;
+    int result;
+} piece_decompress_job;
+
+static void decompress_piece(piece_decompress_job *job)
+{
+    buffer *buf = &savegame_data.pieces[job->piece_index].buf;
+    int output_size = 0;
+    switch (job->codec) {
+        case PIECE_CODEC_ZLIB:
+            job->result = zlib_helper_decompress(job->input, job->input_size, buf->data, (int) buf->size, &output_size);
+            break;
+        case PIECE_CODEC_DELTA_RLE:
+            job->result = delta_rle_decompress(job->input, job->input_size, buf->data, (int) buf->size, &output_size);
+            break;
+        case PIECE_CODEC_ZIP:
+            job->result = zip_decompress(job->input, job->input_size, buf->data, (int) buf->size);
+            break;
+        default:
+            job->result = 0;
+            break;
+    }
+}
+
+static void free_decompress_jobs(piece_decompress_job *jobs, int num_jobs)
+{
+    for (int i = 0; i < num_jobs; i++) {
+        if (jobs[i].owns_input) {
+            free(jobs[i].input);
+        }
+    }
+}
+
+static int decompress_savegame_pieces(piece_decompress_job *jobs, int num_jobs)
+{
+    for (int i = 0; i < num_jobs; i++) {
+        decompress_piece(&jobs[i]);
+    }
+    int result = 1;
+    for (int i = 0; i < num_jobs; i++) {
+        // The last piece may be smaller than buf.size
+        if (!jobs[i].result && jobs[i].piece_index != (savegame_data.num_pieces - 1) && result) {
+            log_info("Incorrect buffer size, got", 0, 0);
+            log_info("Incorrect buffer size, expected", 0, (int) savegame_data.pieces[jobs[i].piece_index].buf.size);
+            result = 0;
+        }
+    }
+    free_decompress_jobs(jobs, num_jobs);
+    return result;
+}
+
+static void filter_grid_pieces(void)
 {
-    memory_block compress_buffer;
-    core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
     for (int i = 0; i < savegame_data.num_pieces; i++) {
+        if (savegame_data.pieces[i].filtered_grid) {
+            map_grid_filter_saved_state(&savegame_data.pieces[i].buf);
+        }
+    }
+}
+
+static int unfilter_grid_pieces(int first_piece, int num_pieces)
+{
+    for (int i = first_piece; i < num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        if (!piece->filtered_grid || !piece->buf.size || piece->from_checkpoint) {
+            continue;
+        }
+        if (piece->mapped) {
+            // the mapped file is read-only
+            uint8_t *data = malloc(piece->buf.size);
+            if (!data) {
+                return 0;
+            }
+            memcpy(data, piece->buf.data, piece->buf.size);
+            buffer_init(&piece->buf, data, (int) piece->buf.size);
+            piece->mapped = 0;
+        }
+        map_grid_unfilter_saved_state(&piece->buf);
+    }
+    return 1;
+}
+
+static int read_uncompressed_piece_from_buffer(buffer *buf, file_piece *piece, int map_pieces)
+{
+    if (map_pieces && buf->index + piece->buf.size <= buf->size) {
+        // the piece reads straight from the mapped file, so it must be cleared before the file is unmapped
+        free(piece->buf.data);
+        buffer_init(&piece->buf, &buf->data[buf->index], (int) piece->buf.size);
+        piece->mapped = 1;
+        buffer_skip(buf, piece->buf.size);
+        return 1;
+    }
+    return buffer_read_raw(buf, piece->buf.data, piece->buf.size) == piece->buf.size;
+}
+
+static int savegame_read_pieces_from_buffer(buffer *buf, savegame_version_t version, int first_piece, int num_pieces,
+    int map_pieces)
+{
+    piece_decompress_job jobs[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    int num_jobs = 0;
+    int read_as_zlib = version > SAVE_GAME_LAST_ZIP_COMPRESSION;
+    int has_piece_codecs = version > SAVE_GAME_LAST_NO_PIECE_CODECS;
+    for (int i = first_piece; i < num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
         size_t result = 0;
         if (!prepare_dynamic_piece_from_buffer(buf, piece)) {
             continue;
         }
         if (piece->compressed) {
-            result = read_compressed_chunk_from_buffer(buf, piece->buf.data, piece->buf.size,
-                version > SAVE_GAME_LAST_ZIP_COMPRESSION, &compress_buffer);
+            piece_codec codec = has_piece_codecs ? buffer_read_i32(buf) :
+                (read_as_zlib ? PIECE_CODEC_ZLIB : PIECE_CODEC_ZIP);
+            int input_size = buffer_read_i32(buf);
+            if ((unsigned int) input_size == UNCOMPRESSED) {
+                result = read_uncompressed_piece_from_buffer(buf, piece, map_pieces);
+            } else if (codec == PIECE_CODEC_CHECKPOINT) {
+                // filled in from the checkpoint once the whole delta save is read
+                piece->from_checkpoint = 1;
+                result = 1;
+            } else if (input_size > 0 && buf->index + input_size <= buf->size) {
+                // decompressed later straight from the buffer
+                piece_decompress_job *job = &jobs[num_jobs++];
+                job->piece_index = i;
+                job->input = &buf->data[buf->index];
+                job->input_size = input_size;
+                job->owns_input = 0;
+                job->codec = codec;
+                buffer_set(buf, (int) (buf->index + input_size));
+                result = 1;
+            }
         } else {
-            result = buffer_read_raw(buf, piece->buf.data, piece->buf.size) == piece->buf.size;
+            result = read_uncompressed_piece_from_buffer(buf, piece, map_pieces);
         }
         // The last piece may be smaller than buf.size
         if (!result && i != (savegame_data.num_pieces - 1)) {
             log_info("Incorrect buffer size, got", 0, (int) result);
             log_info("Incorrect buffer size, expected", 0, (int) piece->buf.size);
-            core_memory_block_free(&compress_buffer);
             return 0;
         }
     }
-    core_memory_block_free(&compress_buffer);
-    return 1;
+    if (!decompress_savegame_pieces(jobs, num_jobs)) {
+        return 0;
+    }
+    return unfilter_grid_pieces(first_piece, num_pieces);
 }
 
-static int savegame_read_from_file(FILE *fp, savegame_version_t version)
+static int savegame_read_from_buffer(buffer *buf, savegame_version_t version, int map_pieces)
 {
-    memory_block compress_buffer;
-    core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
-    for (int i = 0; i < savegame_data.num_pieces; i++) {
+    return savegame_read_pieces_from_buffer(buf, version, 0, savegame_data.num_pieces, map_pieces);
+}
+
+static int savegame_read_pieces_from_file(FILE *fp, savegame_version_t version, int first_piece, int num_pieces)
+{
+    piece_decompress_job jobs[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    int num_jobs = 0;
+    int read_as_zlib = version > SAVE_GAME_LAST_ZIP_COMPRESSION;
+    int has_piece_codecs = version > SAVE_GAME_LAST_NO_PIECE_CODECS;
+    for (int i = first_piece; i < num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
         int result = 0;
         if (!prepare_dynamic_piece_from_file(fp, piece)) {
             continue;
         }
         if (piece->compressed) {
-            result = read_compressed_savegame_chunk(fp, piece->buf.data, piece->buf.size, version, &compress_buffer);
+            piece_codec codec = has_piece_codecs ? read_int32(fp) :
+                (read_as_zlib ? PIECE_CODEC_ZLIB : PIECE_CODEC_ZIP);
+            int input_size = read_int32(fp);
+            if ((unsigned int) input_size == UNCOMPRESSED) {
+                result = fread(piece->buf.data, 1, piece->buf.size, fp) == piece->buf.size;
+            } else if (codec == PIECE_CODEC_CHECKPOINT) {
+                // filled in from the checkpoint once the whole delta save is read
+                piece->from_checkpoint = 1;
+                result = 1;
+            } else if (input_size > 0) {
+                // the pieces are read in order and decompressed together afterwards
+                uint8_t *input = malloc(input_size);
+                if (input && fread(input, 1, input_size, fp) == input_size) {
+                    piece_decompress_job *job = &jobs[num_jobs++];
+                    job->piece_index = i;
+                    job->input = input;
+                    job->input_size = input_size;
+                    job->owns_input = 1;
+                    job->codec = codec;
+                    result = 1;
+                } else {
+                    free(input);
+                }
+            }
         } else {
             result = fread(piece->buf.data, 1, piece->buf.size, fp) == piece->buf.size;
         }
@@ -1415,16 +1692,143 @@ static int savegame_read_from_file(FILE *fp, savegame_version_t version)
         if (!result && i != (savegame_data.num_pieces - 1)) {
             log_info("Incorrect buffer size, got", 0, result);
             log_info("Incorrect buffer size, expected", 0, (int) piece->buf.size);
-            core_memory_block_free(&compress_buffer);
+            free_decompress_jobs(jobs, num_jobs);
             return 0;
         }
     }
-    core_memory_block_free(&compress_buffer);
-    return 1;
+    if (!decompress_savegame_pieces(jobs, num_jobs)) {
+        return 0;
+    }
+    return unfilter_grid_pieces(first_piece, num_pieces);
+}
+
+static int savegame_read_from_file(FILE *fp, savegame_version_t version)
+{
+    return savegame_read_pieces_from_file(fp, version, 0, savegame_data.num_pieces);
+}
+
+typedef struct {
+    file_piece *piece;
+    uint8_t *output;
+    int output_size;
+    piece_codec codec;
+    save_type type;
+    uint64_t hash;
+} piece_compress_job;
+
+static uint64_t hash_piece(const buffer *buf)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < buf->size; i++) {
+        hash ^= buf->data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void compress_piece(piece_compress_job *job)
+{
+    buffer *buf = &job->piece->buf;
+    if (job->type != SAVE_TYPE_FULL) {
+        job->hash = hash_piece(buf);
+    }
+    if (job->type == SAVE_TYPE_DELTA) {
+        int piece_index = (int) (job->piece - savegame_data.pieces);
+        // the file dialog reads the info pieces on their own, so they are always stored
+        if (piece_index >= savegame_data.num_info_pieces && checkpoint_data.piece_sizes[piece_index] == buf->size &&
+            checkpoint_data.piece_hashes[piece_index] == job->hash) {
+            job->codec = PIECE_CODEC_CHECKPOINT;
+            return;
+        }
+    }
+    // pieces that do not fit in the compress buffer were always written uncompressed
+    int output_buffer_size = zlib_helper_compress_bound((int) buf->size);
+    if (output_buffer_size > COMPRESS_BUFFER_INITIAL_SIZE) {
+        output_buffer_size = COMPRESS_BUFFER_INITIAL_SIZE;
+    }
+    job->output = malloc(output_buffer_size);
+    if (!job->output) {
+        return;
+    }
+    int delta_rle_buffer_size = (int) buf->size / DELTA_RLE_MAX_RATIO;
+    if (delta_rle_buffer_size > output_buffer_size) {
+        delta_rle_buffer_size = output_buffer_size;
+    }
+    if (delta_rle_compress(buf->data, (int) buf->size, job->output, delta_rle_buffer_size, &job->output_size)) {
+        job->codec = PIECE_CODEC_DELTA_RLE;
+    } else if (zlib_helper_compress(buf->data, (int) buf->size, job->output, output_buffer_size,
+        &job->output_size)) {
+        job->codec = PIECE_CODEC_ZLIB;
+    } else {
+        free(job->output);
+        job->output = 0;
+    }
+}
+
+static void store_checkpoint_hashes(const piece_compress_job *jobs, int num_jobs)
+{
+    memset(checkpoint_data.piece_sizes, 0, sizeof(checkpoint_data.piece_sizes));
+    uint64_t combined_hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < num_jobs; i++) {
+        int piece_index = (int) (jobs[i].piece - savegame_data.pieces);
+        checkpoint_data.piece_sizes[piece_index] = jobs[i].piece->buf.size;
+        checkpoint_data.piece_hashes[piece_index] = jobs[i].hash;
+        combined_hash = (combined_hash ^ jobs[i].hash) * 0x100000001b3ULL;
+    }
+    checkpoint_data.id = (int) (combined_hash ^ (combined_hash >> 32));
+    if (!checkpoint_data.id) {
+        checkpoint_data.id = 1;
+    }
+}
+
+static void write_checkpoint_piece(save_type type)
+{
+    buffer *buf = savegame_data.state.checkpoint;
+    int size = CHECKPOINT_PIECE_SIZE;
+    if (type == SAVE_TYPE_DELTA) {
+        size += FILE_NAME_MAX;
+    }
+    uint8_t *data = malloc(size);
+    memset(data, 0, size);
+    buffer_init(buf, data, size);
+    buffer_write_i32(buf, checkpoint_data.id);
+    buffer_write_i32(buf, type == SAVE_TYPE_DELTA);
+    if (type == SAVE_TYPE_DELTA) {
+        // stored without its path, so the save and its checkpoint can be moved together
+        char name[FILE_NAME_MAX] = { 0 };
+        snprintf(name, FILE_NAME_MAX, "%s", file_remove_path(checkpoint_data.filename));
+        buffer_write_raw(buf, name, FILE_NAME_MAX);
+    }
 }
 
-static void savegame_write_to_file(FILE *fp, memory_block *compress_buffer)
+static void savegame_write_to_file(FILE *fp, save_type type)
 {
+    piece_compress_job jobs[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    int num_jobs = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        if (piece->compressed && piece->buf.size) {
+            jobs[num_jobs].piece = piece;
+            jobs[num_jobs].output = 0;
+            jobs[num_jobs].output_size = 0;
+            jobs[num_jobs].codec = PIECE_CODEC_NONE;
+            jobs[num_jobs].type = type;
+            jobs[num_jobs].hash = 0;
+            num_jobs++;
+        }
+    }
+    for (int i = 0; i < num_jobs; i++) {
+        compress_piece(&jobs[i]);
+    }
+    if (type == SAVE_TYPE_CHECKPOINT) {
+        store_checkpoint_hashes(jobs, num_jobs);
+    }
+    if (type != SAVE_TYPE_FULL) {
+        write_checkpoint_piece(type);
+    }
+
+    piece_compress_job *job = jobs;
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
         if (piece->dynamic) {
@@ -1434,7 +1838,21 @@ static void savegame_write_to_file(FILE *fp, memory_block *compress_buffer)
             }
         }
         if (piece->compressed) {
-            write_compressed_chunk(fp, piece->buf.data, piece->buf.size, compress_buffer);
+            if (job->codec == PIECE_CODEC_CHECKPOINT) {
+                write_int32(fp, PIECE_CODEC_CHECKPOINT);
+                write_int32(fp, 0);
+            } else if (job->output) {
+                write_int32(fp, job->codec);
+                write_int32(fp, job->output_size);
+                fwrite(job->output, 1, job->output_size, fp);
+                free(job->output);
+            } else {
+                // unable to compress: write uncompressed
+                write_int32(fp, PIECE_CODEC_NONE);
+                write_int32(fp, UNCOMPRESSED);
+                fwrite(piece->buf.data, 1, piece->buf.size, fp);
+            }
+            job++;
         } else {
             fwrite(piece->buf.data, 1, piece->buf.size, fp);
         }
@@ -1482,7 +1900,133 @@ static int get_savegame_versions(FILE *fp, savegame_version_t *save_version, res
     return 1;
 }
 
-int game_file_io_read_save_game_from_buffer(buffer *buf)
+static int skip_checkpoint_piece(FILE *fp, const file_piece *piece, int size)
+{
+    if (!piece->compressed) {
+        return fseek(fp, size, SEEK_CUR) == 0;
+    }
+    read_int32(fp); // codec
+    int input_size = read_int32(fp);
+    if ((unsigned int) input_size == UNCOMPRESSED) {
+        input_size = size;
+    }
+    return input_size >= 0 && fseek(fp, input_size, SEEK_CUR) == 0;
+}
+
+static int savegame_read_checkpoint_pieces_from_file(FILE *fp, int checkpoint_id)
+{
+    piece_decompress_job jobs[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    int num_jobs = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        int size = (int) piece->buf.size;
+        if (piece->dynamic) {
+            size = read_int32(fp);
+            if (!size) {
+                continue;
+            }
+        }
+        int result = 0;
+        if (&piece->buf == savegame_data.state.checkpoint) {
+            // the checkpoint must be the full save the delta save was made against
+            uint8_t data[CHECKPOINT_PIECE_SIZE];
+            buffer buf;
+            buffer_init(&buf, data, CHECKPOINT_PIECE_SIZE);
+            if (size >= CHECKPOINT_PIECE_SIZE && fread(data, 1, CHECKPOINT_PIECE_SIZE, fp) == CHECKPOINT_PIECE_SIZE) {
+                int id = buffer_read_i32(&buf);
+                int is_delta = buffer_read_i32(&buf);
+                result = id == checkpoint_id && !is_delta && fseek(fp, size - CHECKPOINT_PIECE_SIZE, SEEK_CUR) == 0;
+            }
+        } else if (!piece->from_checkpoint) {
+            result = skip_checkpoint_piece(fp, piece, size);
+        } else {
+            if (piece->dynamic) {
+                free(piece->buf.data);
+                uint8_t *data = malloc(size);
+                memset(data, 0, size);
+                buffer_init(&piece->buf, data, size);
+            }
+            piece_codec codec = read_int32(fp);
+            int input_size = read_int32(fp);
+            if ((unsigned int) input_size == UNCOMPRESSED) {
+                result = fread(piece->buf.data, 1, piece->buf.size, fp) == piece->buf.size;
+            } else if (input_size > 0 && codec != PIECE_CODEC_CHECKPOINT) {
+                uint8_t *input = malloc(input_size);
+                if (input && fread(input, 1, input_size, fp) == input_size) {
+                    piece_decompress_job *job = &jobs[num_jobs++];
+                    job->piece_index = i;
+                    job->input = input;
+                    job->input_size = input_size;
+                    job->owns_input = 1;
+                    job->codec = codec;
+                    result = 1;
+                } else {
+                    free(input);
+                }
+            }
+        }
+        if (!result) {
+            free_decompress_jobs(jobs, num_jobs);
+            return 0;
+        }
+    }
+    if (!decompress_savegame_pieces(jobs, num_jobs)) {
+        return 0;
+    }
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        if (piece->from_checkpoint && piece->filtered_grid) {
+            map_grid_unfilter_saved_state(&piece->buf);
+        }
+        piece->from_checkpoint = 0;
+    }
+    return 1;
+}
+
+static int savegame_read_checkpoint(const char *filename, savegame_version_t version)
+{
+    int needs_checkpoint = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        needs_checkpoint |= savegame_data.pieces[i].from_checkpoint;
+    }
+    if (!needs_checkpoint) {
+        return 1;
+    }
+    buffer *buf = savegame_data.state.checkpoint;
+    if (!filename || !buf || buf->size < CHECKPOINT_PIECE_SIZE + FILE_NAME_MAX) {
+        log_error("Unable to load game, the checkpoint of the delta save is unknown.", 0, 0);
+        return 0;
+    }
+    buffer_reset(buf);
+    int checkpoint_id = buffer_read_i32(buf);
+    buffer_skip(buf, sizeof(int32_t));
+    char checkpoint_name[FILE_NAME_MAX];
+    buffer_read_raw(buf, checkpoint_name, FILE_NAME_MAX);
+    checkpoint_name[FILE_NAME_MAX - 1] = 0;
+
+    // the checkpoint is stored next to the delta save
+    char checkpoint_filename[FILE_NAME_MAX];
+    snprintf(checkpoint_filename, FILE_NAME_MAX, "%s", filename);
+    size_t path_length = file_remove_path(filename) - filename;
+    snprintf(&checkpoint_filename[path_length], FILE_NAME_MAX - path_length, "%s", checkpoint_name);
+    log_info("Loading delta save checkpoint", checkpoint_filename, 0);
+    FILE *fp = file_open(checkpoint_filename, "rb");
+    if (!fp) {
+        log_error("Unable to load game, unable to open the checkpoint of the delta save.", 0, 0);
+        return 0;
+    }
+    savegame_version_t checkpoint_version;
+    resource_version_t resource_version;
+    int result = get_savegame_versions(fp, &checkpoint_version, &resource_version) &&
+        checkpoint_version == version && savegame_read_checkpoint_pieces_from_file(fp, checkpoint_id);
+    file_close(fp);
+    if (!result) {
+        log_error("Unable to load game, the checkpoint does not match the delta save.", 0, 0);
+    }
+    return result;
+}
+
+static int read_save_game_from_buffer(buffer *buf, const char *filename, int map_pieces)
 {
     int result = 0;
     savegame_version_t save_version;
@@ -1495,7 +2039,8 @@ int game_file_io_read_save_game_from_buffer(buffer *buf)
         log_info("Savegame version", 0, save_version);
         resource_set_mapping(resource_version);
         init_savegame_data(save_version);
-        result = savegame_read_from_buffer(buf, save_version);
+        result = savegame_read_from_buffer(buf, save_version, map_pieces) &&
+            savegame_read_checkpoint(filename, save_version);
     }
     if (!result) {
         log_error("Unable to load game, incompatible savefile.", 0, 0);
@@ -1506,6 +2051,23 @@ int game_file_io_read_save_game_from_buffer(buffer *buf)
     return FILE_LOAD_SUCCESS;
 }
 
+int game_file_io_read_save_game_from_buffer(buffer *buf)
+{
+    // the buffer outlives the call and the pieces are cleared before returning, so they can point into it
+    return read_save_game_from_buffer(buf, 0, 1);
+}
+
+static int read_saved_game_from_mapped_file(const char *filename, void *data, size_t size, int offset)
+{
+    if (offset < 0 || (size_t) offset >= size) {
+        log_error("Unable to load game, incompatible savefile.", 0, 0);
+        return FILE_LOAD_WRONG_FILE_FORMAT;
+    }
+    buffer buf;
+    buffer_init(&buf, (uint8_t *) data + offset, (int) (size - offset));
+    return read_save_game_from_buffer(&buf, filename, 1);
+}
+
 int game_file_io_read_saved_game(const char *filename, int offset)
 {
     log_info("Loading saved game", filename, 0);
@@ -1514,6 +2076,15 @@ int game_file_io_read_saved_game(const char *filename, int offset)
         log_error("Unable to load game, unable to open file.", 0, 0);
         return FILE_LOAD_DOES_NOT_EXIST;
     }
+    size_t mapped_size;
+    void *mapped_data = file_map(fp, &mapped_size);
+    if (mapped_data) {
+        // uncompressed pieces are read in place and compressed pieces are inflated straight from the mapping
+        file_close(fp);
+        int result = read_saved_game_from_mapped_file(filename, mapped_data, mapped_size, offset);
+        file_unmap(mapped_data, mapped_size);
+        return result;
+    }
     if (offset) {
         fseek(fp, offset, SEEK_SET);
     }
@@ -1532,6 +2103,9 @@ int game_file_io_read_saved_game(const char *filename, int offset)
         result = savegame_read_from_file(fp, save_version);
     }
     file_close(fp);
+    if (result) {
+        result = savegame_read_checkpoint(filename, save_version);
+    }
     if (!result) {
         log_error("Unable to load game, incompatible savefile.", 0, 0);
         return FILE_LOAD_WRONG_FILE_FORMAT;
@@ -1613,7 +2187,8 @@ static void get_saved_game_origin(saved_game_info *info, const savegame_state *s
     file_remove_extension(info->origin.campaign_name);
 }
 
-static savegame_load_status savegame_read_file_info(saved_game_info *info, savegame_version_t version)
+static void savegame_read_basic_info(saved_game_info *info, savegame_version_t version,
+    int *grid_start, int *grid_border_size)
 {
     const savegame_state *state = &savegame_data.state;
     scenario_version_t scenario_version = save_version_to_scenario_version(version, state->scenario_version);
@@ -1639,14 +2214,15 @@ static savegame_load_status savegame_read_file_info(saved_game_info *info, saveg
 
     get_saved_game_origin(info, state);
 
-    int grid_start;
-    int grid_border_size;
-
     minimap_data.version = version;
     scenario_map_data_from_buffer(state->scenario, &minimap_data.city_width, &minimap_data.city_height,
-        &grid_start, &grid_border_size, scenario_version);
+        grid_start, grid_border_size, scenario_version);
     info->map_size = minimap_data.city_width;
     minimap_data.climate = scenario_climate_from_buffer(state->scenario, scenario_version);
+}
+
+static void set_savegame_minimap_functions(void)
+{
     minimap_data.functions.building = savegame_building;
     minimap_data.functions.climate = get_climate;
     minimap_data.functions.map.width = map_width;
@@ -1658,6 +2234,15 @@ static savegame_load_status savegame_read_file_info(saved_game_info *info, saveg
     minimap_data.functions.offset.random = savegame_random_at;
     minimap_data.functions.offset.terrain = savegame_terrain_at;
     minimap_data.functions.offset.tile_size = savegame_tile_size_at;
+}
+
+static savegame_load_status savegame_read_file_info(saved_game_info *info, savegame_version_t version)
+{
+    int grid_start;
+    int grid_border_size;
+
+    savegame_read_basic_info(info, version, &grid_start, &grid_border_size);
+    set_savegame_minimap_functions();
 
     city_view_set_custom_lookup(grid_start, minimap_data.city_width, minimap_data.city_height, grid_border_size);
     widget_minimap_update(&minimap_data.functions);
@@ -1668,6 +2253,189 @@ static savegame_load_status savegame_read_file_info(saved_game_info *info, saveg
     return SAVEGAME_STATUS_OK;
 }
 
+static void write_win_criteria(buffer *buf, const struct win_criteria_t *criteria)
+{
+    buffer_write_i32(buf, criteria->enabled);
+    buffer_write_i32(buf, criteria->goal);
+}
+
+static void read_win_criteria(buffer *buf, struct win_criteria_t *criteria)
+{
+    criteria->enabled = buffer_read_i32(buf);
+    criteria->goal = buffer_read_i32(buf);
+}
+
+static void write_file_info_header(buffer *buf, const saved_game_info *info)
+{
+    int size = FILE_INFO_HEADER_SIZE;
+    uint8_t *data = malloc(size);
+    memset(data, 0, size);
+    buffer_init(buf, data, size);
+
+    buffer_write_i32(buf, info->origin.type);
+    buffer_write_i32(buf, info->origin.mission);
+    buffer_write_raw(buf, info->origin.scenario_name, MAX_SCENARIO_NAME);
+    buffer_write_raw(buf, info->origin.campaign_name, FILE_NAME_MAX);
+    buffer_write_i32(buf, info->treasury);
+    buffer_write_i32(buf, info->population);
+    buffer_write_i32(buf, info->month);
+    buffer_write_i32(buf, info->year);
+    buffer_write_raw(buf, info->description, MAX_BRIEF_DESCRIPTION);
+    buffer_write_i32(buf, info->image_id);
+    buffer_write_i32(buf, info->start_year);
+    buffer_write_i32(buf, info->climate);
+    buffer_write_i32(buf, info->map_size);
+    buffer_write_i32(buf, info->total_invasions);
+    buffer_write_i32(buf, info->player_rank);
+    buffer_write_i32(buf, info->is_open_play);
+    buffer_write_i32(buf, info->open_play_id);
+
+    const scenario_win_criteria *criteria = &info->win_criteria;
+    write_win_criteria(buf, &criteria->population);
+    write_win_criteria(buf, &criteria->culture);
+    write_win_criteria(buf, &criteria->prosperity);
+    write_win_criteria(buf, &criteria->peace);
+    write_win_criteria(buf, &criteria->favor);
+    buffer_write_i32(buf, criteria->time_limit.enabled);
+    buffer_write_i32(buf, criteria->time_limit.years);
+    buffer_write_i32(buf, criteria->survival_time.enabled);
+    buffer_write_i32(buf, criteria->survival_time.years);
+    buffer_write_i32(buf, criteria->milestone25_year);
+    buffer_write_i32(buf, criteria->milestone50_year);
+    buffer_write_i32(buf, criteria->milestone75_year);
+
+    buffer_write_i32(buf, minimap_data.city_width);
+    buffer_write_i32(buf, minimap_data.city_height);
+}
+
+static void read_file_info_header(buffer *buf, saved_game_info *info)
+{
+    info->origin.type = buffer_read_i32(buf);
+    info->origin.mission = buffer_read_i32(buf);
+    buffer_read_raw(buf, info->origin.scenario_name, MAX_SCENARIO_NAME);
+    buffer_read_raw(buf, info->origin.campaign_name, FILE_NAME_MAX);
+    info->treasury = buffer_read_i32(buf);
+    info->population = buffer_read_i32(buf);
+    info->month = buffer_read_i32(buf);
+    info->year = buffer_read_i32(buf);
+    buffer_read_raw(buf, info->description, MAX_BRIEF_DESCRIPTION);
+    info->image_id = buffer_read_i32(buf);
+    info->start_year = buffer_read_i32(buf);
+    info->climate = buffer_read_i32(buf);
+    info->map_size = buffer_read_i32(buf);
+    info->total_invasions = buffer_read_i32(buf);
+    info->player_rank = buffer_read_i32(buf);
+    info->is_open_play = buffer_read_i32(buf);
+    info->open_play_id = buffer_read_i32(buf);
+
+    scenario_win_criteria *criteria = &info->win_criteria;
+    read_win_criteria(buf, &criteria->population);
+    read_win_criteria(buf, &criteria->culture);
+    read_win_criteria(buf, &criteria->prosperity);
+    read_win_criteria(buf, &criteria->peace);
+    read_win_criteria(buf, &criteria->favor);
+    criteria->time_limit.enabled = buffer_read_i32(buf);
+    criteria->time_limit.years = buffer_read_i32(buf);
+    criteria->survival_time.enabled = buffer_read_i32(buf);
+    criteria->survival_time.years = buffer_read_i32(buf);
+    criteria->milestone25_year = buffer_read_i32(buf);
+    criteria->milestone50_year = buffer_read_i32(buf);
+    criteria->milestone75_year = buffer_read_i32(buf);
+
+    minimap_data.city_width = buffer_read_i32(buf);
+    minimap_data.city_height = buffer_read_i32(buf);
+}
+
+static void write_minimap(buffer *buf)
+{
+    int width, height, stride;
+    const color_t *pixels = widget_minimap_get_pixels(&width, &height, &stride);
+    if (!pixels) {
+        return;
+    }
+    int size = 2 * sizeof(int32_t) + width * height * sizeof(color_t);
+    uint8_t *data = malloc(size);
+    if (!data) {
+        return;
+    }
+    buffer_init(buf, data, size);
+    buffer_write_i32(buf, width);
+    buffer_write_i32(buf, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            buffer_write_u32(buf, pixels[y * stride + x]);
+        }
+    }
+}
+
+static int read_minimap(buffer *buf)
+{
+    if (!buf->size) {
+        return 0;
+    }
+    int width = buffer_read_i32(buf);
+    int height = buffer_read_i32(buf);
+    if (width <= 0 || height <= 0 || buf->size != 2 * sizeof(int32_t) + (size_t) width * height * sizeof(color_t)) {
+        return 0;
+    }
+    color_t *pixels = malloc(width * height * sizeof(color_t));
+    if (!pixels) {
+        return 0;
+    }
+    for (int i = 0; i < width * height; i++) {
+        pixels[i] = buffer_read_u32(buf);
+    }
+    widget_minimap_update_from_pixels(&minimap_data.functions, pixels, width, height);
+    free(pixels);
+    return 1;
+}
+
+static void savegame_save_file_info(savegame_state *state, int with_minimap)
+{
+    // the info is read back from the saved pieces, so it matches what older versions show in the file dialog
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        buffer_reset(&savegame_data.pieces[i].buf);
+    }
+    saved_game_info info;
+    memset(&info, 0, sizeof(saved_game_info));
+    int grid_start;
+    int grid_border_size;
+    savegame_read_basic_info(&info, SAVE_GAME_CURRENT_VERSION, &grid_start, &grid_border_size);
+    write_file_info_header(state->file_info, &info);
+
+    if (!with_minimap) {
+        // the file dialog draws the minimap from the map pieces instead
+        return;
+    }
+    set_savegame_minimap_functions();
+    city_view_set_custom_lookup(grid_start, minimap_data.city_width, minimap_data.city_height, grid_border_size);
+    widget_minimap_update(&minimap_data.functions);
+    city_view_restore_lookup();
+    write_minimap(state->minimap);
+    // the city minimap was overwritten by the thumbnail
+    widget_minimap_invalidate();
+}
+
+static savegame_load_status savegame_read_file_info_header(saved_game_info *info)
+{
+    const savegame_state *state = &savegame_data.state;
+
+    read_file_info_header(state->file_info, info);
+    minimap_data.version = SAVE_GAME_CURRENT_VERSION;
+    minimap_data.climate = info->climate;
+    memset(&minimap_data.functions, 0, sizeof(minimap_functions));
+    minimap_data.functions.climate = get_climate;
+    minimap_data.functions.map.width = map_width;
+    minimap_data.functions.map.height = map_height;
+    minimap_data.functions.viewport = set_viewport;
+
+    int has_minimap = read_minimap(state->minimap);
+
+    clear_savegame_pieces();
+
+    return has_minimap ? SAVEGAME_STATUS_OK : SAVEGAME_STATUS_INVALID;
+}
+
 int game_file_io_read_saved_game_info(const char *filename, int offset, saved_game_info *info)
 {
     memset(info, 0, sizeof(saved_game_info));
@@ -1696,8 +2464,24 @@ int game_file_io_read_saved_game_info(const char *filename, int offset, saved_ga
     }
     resource_set_mapping(resource_version);
     init_savegame_data(save_version);
-    result = savegame_read_from_file(fp, save_version);
+    if (savegame_data.num_info_pieces) {
+        // newer saves start with the file info and a pre-rendered minimap, so the rest of the file can be skipped
+        result = savegame_read_pieces_from_file(fp, save_version, 0, savegame_data.num_info_pieces);
+        if (result == SAVEGAME_STATUS_OK && savegame_data.state.minimap->size) {
+            file_close(fp);
+            return savegame_read_file_info_header(info);
+        }
+        if (result == SAVEGAME_STATUS_OK) {
+            result = savegame_read_pieces_from_file(fp, save_version,
+                savegame_data.num_info_pieces, savegame_data.num_pieces);
+        }
+    } else {
+        result = savegame_read_from_file(fp, save_version);
+    }
     file_close(fp);
+    if (result == SAVEGAME_STATUS_OK) {
+        result = savegame_read_checkpoint(filename, save_version);
+    }
     if (result != SAVEGAME_STATUS_OK) {
         return FILE_LOAD_WRONG_FILE_FORMAT;
     }
@@ -1722,7 +2506,18 @@ int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *
         log_info("Savegame version", 0, save_version);
         resource_set_mapping(resource_version);
         init_savegame_data(save_version);
-        result = savegame_read_from_buffer(buf, save_version);
+        if (savegame_data.num_info_pieces) {
+            result = savegame_read_pieces_from_buffer(buf, save_version, 0, savegame_data.num_info_pieces, 0);
+            if (result && savegame_data.state.minimap->size) {
+                return savegame_read_file_info_header(info);
+            }
+            if (result) {
+                result = savegame_read_pieces_from_buffer(buf, save_version,
+                    savegame_data.num_info_pieces, savegame_data.num_pieces, 0);
+            }
+        } else {
+            result = savegame_read_from_buffer(buf, save_version, 0);
+        }
     }
     if (!result) {
         log_error("Unable to load game, incompatible savefile.", 0, 0);
@@ -1731,28 +2526,194 @@ int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *
     return savegame_read_file_info(info, save_version);
 }
 
-int game_file_io_write_saved_game(const char *filename)
+static int write_saved_game(const char *filename, save_type type, int with_minimap)
 {
     resource_set_mapping(RESOURCE_CURRENT_VERSION);
     init_savegame_data(SAVE_GAME_CURRENT_VERSION);
 
     log_info("Saving game", filename, 0);
     savegame_save_to_state(&savegame_data.state);
+    savegame_save_file_info(&savegame_data.state, with_minimap);
+    filter_grid_pieces();
 
     FILE *fp = file_open(filename, "wb");
     if (!fp) {
         log_error("Unable to save game", 0, 0);
+        clear_savegame_pieces();
         return 0;
     }
-    memory_block compress_buffer;
-    core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
-    savegame_write_to_file(fp, &compress_buffer);
-    core_memory_block_free(&compress_buffer);
+    savegame_write_to_file(fp, type);
     clear_savegame_pieces();
     file_close(fp);
     return 1;
 }
 
+int game_file_io_write_saved_game(const char *filename)
+{
+    return write_saved_game(filename, SAVE_TYPE_FULL, 1);
+}
+
+int game_file_io_write_autosave(const char *filename)
+{
+    return write_saved_game(filename, SAVE_TYPE_FULL, 0);
+}
+
+int game_file_io_write_delta_saved_game(const char *filename, const char *checkpoint_filename,
+    const char *alternate_checkpoint_filename)
+{
+    char previous_checkpoint_filename[FILE_NAME_MAX] = { 0 };
+    if (!checkpoint_data.id || checkpoint_data.delta_saves >= DELTA_SAVES_PER_CHECKPOINT ||
+        (strcmp(checkpoint_data.filename, checkpoint_filename) != 0 &&
+        strcmp(checkpoint_data.filename, alternate_checkpoint_filename) != 0)) {
+        // the checkpoint the last delta save refers to is kept until the new delta save is written,
+        // so an interrupted autosave never leaves a delta save without its checkpoint
+        int use_alternate = checkpoint_data.id ? strcmp(checkpoint_data.filename, checkpoint_filename) == 0 :
+            file_exists(checkpoint_filename, NOT_LOCALIZED);
+        snprintf(previous_checkpoint_filename, FILE_NAME_MAX, "%s",
+            use_alternate ? checkpoint_filename : alternate_checkpoint_filename);
+        snprintf(checkpoint_data.filename, FILE_NAME_MAX, "%s",
+            use_alternate ? alternate_checkpoint_filename : checkpoint_filename);
+        checkpoint_data.delta_saves = 0;
+        if (!write_saved_game(checkpoint_data.filename, SAVE_TYPE_CHECKPOINT, 0)) {
+            checkpoint_data.id = 0;
+            return 0;
+        }
+    }
+    checkpoint_data.delta_saves++;
+    if (!write_saved_game(filename, SAVE_TYPE_DELTA, 0)) {
+        return 0;
+    }
+    if (*previous_checkpoint_filename && file_exists(previous_checkpoint_filename, NOT_LOCALIZED)) {
+        file_remove(previous_checkpoint_filename);
+    }
+    return 1;
+}
+
+static void add_codec_stats(file_io_codec_stats *stats, const buffer *buf, int compressed_size,
+    uint64_t compress_microseconds, uint64_t decompress_microseconds)
+{
+    stats->pieces++;
+    stats->uncompressed_bytes += buf->size;
+    stats->compressed_bytes += compressed_size;
+    stats->compress_microseconds += compress_microseconds;
+    stats->decompress_microseconds += decompress_microseconds;
+}
+
+static int measure_zlib(const buffer *buf, uint8_t *output, int output_buffer_size, uint8_t *check,
+    int rounds, file_io_codec_stats *stats)
+{
+    int output_size;
+    uint64_t start = system_get_microseconds();
+    for (int i = 0; i < rounds; i++) {
+        if (!zlib_helper_compress(buf->data, (int) buf->size, output, output_buffer_size, &output_size)) {
+            return 0;
+        }
+    }
+    uint64_t compressed = system_get_microseconds();
+    int check_size;
+    for (int i = 0; i < rounds; i++) {
+        if (!zlib_helper_decompress(output, output_size, check, (int) buf->size, &check_size)) {
+            return 0;
+        }
+    }
+    uint64_t decompressed = system_get_microseconds();
+    add_codec_stats(stats, buf, output_size, compressed - start, decompressed - compressed);
+    return 1;
+}
+
+static int measure_delta_rle(const buffer *buf, uint8_t *output, int output_buffer_size, uint8_t *check,
+    int rounds, file_io_codec_stats *stats)
+{
+    int delta_rle_buffer_size = (int) buf->size / DELTA_RLE_MAX_RATIO;
+    if (delta_rle_buffer_size > output_buffer_size) {
+        delta_rle_buffer_size = output_buffer_size;
+    }
+    int output_size;
+    uint64_t start = system_get_microseconds();
+    for (int i = 0; i < rounds; i++) {
+        if (!delta_rle_compress(buf->data, (int) buf->size, output, delta_rle_buffer_size, &output_size)) {
+            return 0;
+        }
+    }
+    uint64_t compressed = system_get_microseconds();
+    int check_size;
+    for (int i = 0; i < rounds; i++) {
+        if (!delta_rle_decompress(output, output_size, check, (int) buf->size, &check_size)) {
+            return 0;
+        }
+    }
+    uint64_t decompressed = system_get_microseconds();
+    add_codec_stats(stats, buf, output_size, compressed - start, decompressed - compressed);
+    return 1;
+}
+
+void game_file_io_measure_codecs(file_io_codec_benchmark *benchmark, int rounds)
+{
+    memset(benchmark, 0, sizeof(file_io_codec_benchmark));
+    resource_set_mapping(RESOURCE_CURRENT_VERSION);
+    memset(&savegame_data.state, 0, sizeof(savegame_state));
+    init_savegame_data(SAVE_GAME_CURRENT_VERSION);
+    savegame_save_to_state(&savegame_data.state);
+    uint8_t *output = malloc(COMPRESS_BUFFER_INITIAL_SIZE);
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const file_piece *piece = &savegame_data.pieces[i];
+        if (!piece->buf.size) {
+            continue;
+        }
+        benchmark->pieces++;
+        benchmark->state_bytes += piece->buf.size;
+        if (!piece->compressed || !output) {
+            continue;
+        }
+        // same output buffer limit as when the piece is saved
+        int output_buffer_size = zlib_helper_compress_bound((int) piece->buf.size);
+        if (output_buffer_size > COMPRESS_BUFFER_INITIAL_SIZE) {
+            output_buffer_size = COMPRESS_BUFFER_INITIAL_SIZE;
+        }
+        uint8_t *check = malloc(piece->buf.size);
+        if (!check) {
+            continue;
+        }
+        measure_zlib(&piece->buf, output, output_buffer_size, check, rounds, &benchmark->zlib);
+        if (measure_delta_rle(&piece->buf, output, output_buffer_size, check, rounds, &benchmark->delta_rle)) {
+            measure_zlib(&piece->buf, output, output_buffer_size, check, rounds,
+                &benchmark->zlib_on_delta_rle_pieces);
+        }
+        free(check);
+    }
+    free(output);
+    clear_savegame_pieces();
+}
+
+static const char *get_piece_name(const buffer *buf)
+{
+    buffer *const *state_pieces = (buffer *const *) &savegame_data.state;
+    int num_names = sizeof(SAVEGAME_PIECE_NAMES) / sizeof(SAVEGAME_PIECE_NAMES[0]);
+    for (int i = 0; i < sizeof(savegame_state) / sizeof(buffer *) && i < num_names; i++) {
+        if (state_pieces[i] == buf) {
+            return SAVEGAME_PIECE_NAMES[i];
+        }
+    }
+    return "unknown";
+}
+
+void game_file_io_hash_state(void (*callback)(const char *piece_name, uint64_t hash))
+{
+    resource_set_mapping(RESOURCE_CURRENT_VERSION);
+    // pieces that the current version does not have must not keep pointing at reused pieces
+    memset(&savegame_data.state, 0, sizeof(savegame_state));
+    init_savegame_data(SAVE_GAME_CURRENT_VERSION);
+    savegame_save_to_state(&savegame_data.state);
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const buffer *buf = &savegame_data.pieces[i].buf;
+        // pieces that are only filled in when writing a file carry no game state
+        if (buf->size) {
+            callback(get_piece_name(buf), hash_piece(buf));
+        }
+    }
+    clear_savegame_pieces();
+}
+
 int game_file_io_delete_saved_game(const char *filename)
 {
     log_info("Deleting game", filename, 0);
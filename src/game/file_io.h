@@ -53,6 +53,59 @@ int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *
 
 int game_file_io_write_saved_game(const char *filename);
 
+/**
+ * Writes a saved game without the minimap thumbnail, which is not worth rendering for every autosave
+ * @param filename Saved game to write
+ * @return 1 on success, 0 on failure
+ */
+int game_file_io_write_autosave(const char *filename);
+
+/**
+ * Writes a saved game that only contains the pieces that changed since the last full checkpoint.
+ * A new checkpoint is written first when there is none yet or when it is due. It goes to whichever
+ * of the two checkpoint files the previous delta save does not use, and the previous one is only removed
+ * once the new delta save is written.
+ * Like other autosaves, neither has a minimap thumbnail.
+ * @param filename Saved game to write
+ * @param checkpoint_filename Checkpoint to write the full state to, in the same directory as the saved game
+ * @param alternate_checkpoint_filename Checkpoint to write to when the other one is still in use
+ * @return 1 on success, 0 on failure
+ */
+int game_file_io_write_delta_saved_game(const char *filename, const char *checkpoint_filename,
+    const char *alternate_checkpoint_filename);
+
+/**
+ * Hashes every piece of the current game state as it would be saved, without writing a file
+ * @param callback Function called with the name and the 64-bit FNV-1a hash of every piece, in file order
+ */
+void game_file_io_hash_state(void (*callback)(const char *piece_name, uint64_t hash));
+
+typedef struct {
+    int pieces;
+    uint64_t uncompressed_bytes;
+    uint64_t compressed_bytes;
+    uint64_t compress_microseconds;
+    uint64_t decompress_microseconds;
+} file_io_codec_stats;
+
+typedef struct {
+    int pieces;
+    uint64_t state_bytes;
+    file_io_codec_stats zlib;
+    file_io_codec_stats delta_rle;
+    file_io_codec_stats zlib_on_delta_rle_pieces;
+} file_io_codec_benchmark;
+
+/**
+ * Compresses and decompresses every compressed piece of the current game state with each codec,
+ * on the calling thread, to measure how small and how fast each codec makes it
+ * @param benchmark Filled in with the size of the state, the zlib figures for every compressed piece,
+ *                  the delta-RLE figures for the pieces a saved game stores with delta-RLE,
+ *                  and the zlib figures for those same pieces. The times are the totals over all rounds.
+ * @param rounds Number of times to compress and decompress every piece
+ */
+void game_file_io_measure_codecs(file_io_codec_benchmark *benchmark, int rounds);
+
 int game_file_io_delete_saved_game(const char *filename);
 
 #endif // GAME_FILE_IO_H
@@ -10,9 +10,11 @@
 #include "core/lang.h"
 #include "core/locale.h"
 #include "core/log.h"
+#include "core/performance.h"
 #include "core/random.h"
 #include "core/string.h"
 #include "editor/editor.h"
+#include "figure/figure.h"
 #include "figure/type.h"
 #include "game/animation.h"
 #include "game/campaign.h"
@@ -39,6 +41,8 @@
 #include "window/logo.h"
 #include "window/main_menu.h"
 
+#include <stdio.h>
+
 static void errlog(const char *msg)
 {
     log_error(msg, 0, 0);
@@ -159,6 +163,7 @@ static int reload_language(int is_editor, int reload_images)
         errlog("unable to load font graphics");
         return 0;
     }
+    text_invalidate_layout_cache();
     if (!image_load_climate(scenario_property_climate(), is_editor, reload_images, 0)) {
         errlog("unable to load main graphics");
         return 0;
@@ -201,24 +206,52 @@ int game_reload_language(void)
     return reload_language(editor_is_active(), 1);
 }
 
+static int count_alive_figures(void)
+{
+    int alive = 0;
+    for (int i = 1; i < figure_count(); i++) {
+        if (!figure_is_dead(figure_get(i))) {
+            alive++;
+        }
+    }
+    return alive;
+}
+
 void game_run(void)
 {
     game_animation_update();
     int num_ticks = game_speed_get_elapsed_ticks();
-    for (int i = 0; i < num_ticks; i++) {
+    performance_add(PERFORMANCE_COUNTER_TICKS_DUE, num_ticks);
+    int ticks_run = 0;
+    while (ticks_run < num_ticks) {
         game_tick_run();
         game_file_write_mission_saved_game();
+        performance_add(PERFORMANCE_COUNTER_TICKS, 1);
+        ticks_run++;
 
         if (window_is_invalid()) {
+            num_ticks = ticks_run;
+            break;
+        }
+        // slow ticks are spread over the next frames instead of stalling this one
+        if (game_speed_tick_budget_exhausted()) {
             break;
         }
     }
+    game_speed_set_ticks_run(ticks_run, num_ticks);
+    if (performance_is_enabled()) {
+        performance_set(PERFORMANCE_COUNTER_FIGURES, count_alive_figures());
+    }
 }
 
 void game_draw(void)
 {
+    performance_start_phase(PERFORMANCE_PHASE_DRAW);
     window_draw(0);
+    performance_end_phase(PERFORMANCE_PHASE_DRAW);
+    performance_start_phase(PERFORMANCE_PHASE_SOUND);
     sound_city_play();
+    performance_end_phase(PERFORMANCE_PHASE_SOUND);
 }
 
 void game_display_fps(int fps)
@@ -232,6 +265,47 @@ void game_display_fps(int fps)
     text_draw_number_centered_colored(fps, x_offset, y_offset + 6, width, FONT_SMALL_PLAIN, COLOR_BLACK);
 }
 
+void game_display_performance(void)
+{
+    performance_statistics stats;
+    performance_get_statistics(&stats);
+
+    char lines[5][100];
+    snprintf(lines[0], sizeof(lines[0]), "Frame ms  50%%: %.2f  95%%: %.2f  99%%: %.2f  max: %.2f",
+        stats.frame_time_median / 1000.0, stats.frame_time_95th / 1000.0,
+        stats.frame_time_99th / 1000.0, stats.frame_time_max / 1000.0);
+    snprintf(lines[1], sizeof(lines[1]), "Input %.2f  Run %.2f  Draw %.2f  Sound %.2f  Render %.2f",
+        stats.phase_time[PERFORMANCE_PHASE_INPUT] / 1000.0, stats.phase_time[PERFORMANCE_PHASE_RUN] / 1000.0,
+        stats.phase_time[PERFORMANCE_PHASE_DRAW] / 1000.0, stats.phase_time[PERFORMANCE_PHASE_SOUND] / 1000.0,
+        stats.phase_time[PERFORMANCE_PHASE_RENDER] / 1000.0);
+    snprintf(lines[2], sizeof(lines[2]), "Ticks run: %d  due: %d  in %d frames",
+        stats.counters_total[PERFORMANCE_COUNTER_TICKS], stats.counters_total[PERFORMANCE_COUNTER_TICKS_DUE],
+        stats.num_frames);
+    snprintf(lines[3], sizeof(lines[3]), "Draw calls: %d  Texture switches: %d",
+        stats.counters_last[PERFORMANCE_COUNTER_DRAW_CALLS],
+        stats.counters_last[PERFORMANCE_COUNTER_TEXTURE_SWITCHES]);
+    snprintf(lines[4], sizeof(lines[4]), "Figures: %d  Routes: %d  Font atlas misses: %d in %d frames",
+        stats.counters_last[PERFORMANCE_COUNTER_FIGURES], stats.counters_total[PERFORMANCE_COUNTER_ROUTES],
+        stats.counters_total[PERFORMANCE_COUNTER_FONT_ATLAS_MISSES], stats.num_frames);
+
+    int x_offset = 40;
+    int y_offset = 24;
+    int width = 0;
+    for (int i = 0; i < 5; i++) {
+        int line_width = text_get_width(string_from_ascii(lines[i]), FONT_SMALL_PLAIN);
+        if (line_width > width) {
+            width = line_width;
+        }
+    }
+    width += 12;
+    int height = 5 * 12 + 8;
+    graphics_draw_rect(x_offset, y_offset, width + 2, height + 2, COLOR_BLACK);
+    graphics_fill_rect(x_offset + 1, y_offset + 1, width, height, COLOR_WHITE);
+    for (int i = 0; i < 5; i++) {
+        text_draw(string_from_ascii(lines[i]), x_offset + 7, y_offset + 6 + i * 12, FONT_SMALL_PLAIN, COLOR_BLACK);
+    }
+}
+
 void game_exit(void)
 {
     video_shutdown();
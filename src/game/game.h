@@ -15,6 +15,8 @@ void game_draw(void);
 
 void game_display_fps(int fps);
 
+void game_display_performance(void);
+
 void game_exit_editor(void);
 
 void game_exit(void);
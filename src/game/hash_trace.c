@@ -0,0 +1,214 @@
+#include "hash_trace.h"
+
+#include "building/maintenance.h"
+#include "core/dir.h"
+#include "core/log.h"
+#include "figure/route.h"
+#include "game/file.h"
+#include "game/file_io.h"
+#include "game/tick.h"
+#include "game/time.h"
+#include "map/natives.h"
+#include "map/road_network.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAVE_RELOAD_CHECK_FILE "save-reload-check.svx"
+
+static int current_tick;
+
+static void print_piece_hash(const char *piece_name, uint64_t hash)
+{
+    printf("%d %s %08x%08x\n", current_tick, piece_name, (unsigned int) (hash >> 32), (unsigned int) hash);
+}
+
+void game_hash_trace_print(int tick)
+{
+    current_tick = tick;
+    game_file_io_hash_state(print_piece_hash);
+    fflush(stdout);
+}
+
+int game_hash_trace_run(const char *filename, int num_ticks, int interval)
+{
+    if (game_file_load_saved_game(filename) != FILE_LOAD_SUCCESS) {
+        log_error("Unable to load saved game for hash trace", filename, 0);
+        return 0;
+    }
+    if (interval <= 0) {
+        interval = 1;
+    }
+    game_hash_trace_print(0);
+    for (int tick = 1; tick <= num_ticks; tick++) {
+        game_tick_run();
+        if (tick % interval == 0 || tick == num_ticks) {
+            game_hash_trace_print(tick);
+        }
+    }
+    return 1;
+}
+
+static struct {
+    uint64_t *hashes;
+    int num_pieces;
+    int tick;
+    int piece;
+    int is_reference_run;
+    int mismatches;
+    const char *ignored_piece;
+} check;
+
+static void count_piece(const char *piece_name, uint64_t hash)
+{
+    check.num_pieces++;
+}
+
+static void check_piece_hash(const char *piece_name, uint64_t hash)
+{
+    if (check.piece >= check.num_pieces) {
+        return;
+    }
+    uint64_t *reference = &check.hashes[check.tick * check.num_pieces + check.piece];
+    check.piece++;
+    if (check.ignored_piece && strcmp(piece_name, check.ignored_piece) == 0) {
+        return;
+    }
+    if (check.is_reference_run) {
+        *reference = hash;
+    } else if (*reference != hash) {
+        printf("%d %s differs\n", check.tick, piece_name);
+        check.mismatches++;
+    }
+}
+
+static void update_as_when_loading(void)
+{
+    // loading a game updates these right away, while the running game only does so later or never
+    figure_route_clean();
+    map_road_network_update();
+    building_maintenance_check_rome_access();
+    map_natives_check_land(0);
+}
+
+static int allocate_hashes(int num_ticks)
+{
+    if (check.hashes) {
+        return 1;
+    }
+    check.num_pieces = 0;
+    game_file_io_hash_state(count_piece);
+    check.hashes = malloc(sizeof(uint64_t) * check.num_pieces * (num_ticks + 1));
+    if (!check.hashes) {
+        log_error("Unable to allocate memory for the hash check", 0, 0);
+        return 0;
+    }
+    return 1;
+}
+
+static void check_ticks(int num_ticks)
+{
+    for (check.tick = 0; check.tick <= num_ticks; check.tick++) {
+        if (check.tick > 0) {
+            game_tick_run();
+        }
+        check.piece = 0;
+        game_file_io_hash_state(check_piece_hash);
+        if (check.mismatches) {
+            // later ticks only differ because of this one
+            break;
+        }
+    }
+}
+
+static int run_check(const char *filename, int num_ticks)
+{
+    if (game_file_load_saved_game(filename) != FILE_LOAD_SUCCESS) {
+        log_error("Unable to load saved game for determinism check", filename, 0);
+        return 0;
+    }
+    if (!allocate_hashes(num_ticks)) {
+        return 0;
+    }
+    check_ticks(num_ticks);
+    return 1;
+}
+
+int game_hash_trace_check_determinism(const char *filename, int num_ticks)
+{
+    if (num_ticks < 0) {
+        num_ticks = 0;
+    }
+    check.mismatches = 0;
+    check.is_reference_run = 1;
+    int ok = run_check(filename, num_ticks);
+    if (ok) {
+        check.is_reference_run = 0;
+        ok = run_check(filename, num_ticks);
+    }
+    free(check.hashes);
+    check.hashes = 0;
+    if (!ok) {
+        return 0;
+    }
+    if (check.mismatches) {
+        log_error("Determinism check failed: second run differs from first run at tick", 0, check.tick);
+        return 0;
+    }
+    printf("%d ticks identical\n", num_ticks);
+    fflush(stdout);
+    return 1;
+}
+
+int game_hash_trace_check_save_reload(const char *filename, int save_ticks, int num_ticks)
+{
+    if (num_ticks < 0) {
+        num_ticks = 0;
+    }
+    if (game_file_load_saved_game(filename) != FILE_LOAD_SUCCESS) {
+        log_error("Unable to load saved game for save and reload check", filename, 0);
+        return 0;
+    }
+    for (int tick = 0; tick < save_ticks; tick++) {
+        game_tick_run();
+    }
+    int save_tick = game_time_tick();
+    char save_filename[FILE_NAME_MAX];
+    snprintf(save_filename, FILE_NAME_MAX, "%s", dir_append_location(SAVE_RELOAD_CHECK_FILE, PATH_LOCATION_SAVEGAME));
+    if (!game_file_write_saved_game(save_filename)) {
+        log_error("Unable to write saved game for save and reload check", save_filename, 0);
+        return 0;
+    }
+    update_as_when_loading();
+    // loading recalculates the routes, which adds to the route counters without changing the game
+    check.ignored_piece = "routing_counters";
+    check.mismatches = 0;
+    check.is_reference_run = 1;
+    int ok = allocate_hashes(num_ticks);
+    if (ok) {
+        check_ticks(num_ticks);
+        check.is_reference_run = 0;
+        if (game_file_load_saved_game(save_filename) == FILE_LOAD_SUCCESS) {
+            check_ticks(num_ticks);
+        } else {
+            log_error("Unable to load saved game for save and reload check", save_filename, 0);
+            ok = 0;
+        }
+    }
+    game_file_delete_saved_game(save_filename);
+    check.ignored_piece = 0;
+    free(check.hashes);
+    check.hashes = 0;
+    if (!ok) {
+        return 0;
+    }
+    if (check.mismatches) {
+        log_error("Save and reload check failed: reloaded game differs from the continued game at tick",
+            0, check.tick);
+        return 0;
+    }
+    printf("saved at tick %d of the day, %d ticks identical\n", save_tick, num_ticks);
+    fflush(stdout);
+    return 1;
+}
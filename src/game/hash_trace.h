@@ -0,0 +1,48 @@
+#ifndef GAME_HASH_TRACE_H
+#define GAME_HASH_TRACE_H
+
+/**
+ * @file
+ * Prints hashes of the game state while the game runs without player input,
+ * so that two builds can be compared tick by tick.
+ */
+
+/**
+ * Loads a saved game, runs the given number of ticks and prints the hash of every saved game piece
+ * to the standard output, as "tick piece hash" lines, at the start and every interval ticks
+ * @param filename Saved game to start from
+ * @param num_ticks Number of ticks to run
+ * @param interval Number of ticks between two traces
+ * @return 1 if the trace completed, 0 if the saved game could not be loaded
+ */
+int game_hash_trace_run(const char *filename, int num_ticks, int interval);
+
+/**
+ * Prints the hash of every saved game piece of the current game to the standard output
+ * @param tick Tick number to print in front of the hashes
+ */
+void game_hash_trace_print(int tick);
+
+/**
+ * Runs the given number of ticks from a saved game twice in the same process and compares the hash of
+ * every saved game piece after every tick, to find state that is not reset when a game is loaded.
+ * The first differing pieces are printed to the standard output as "tick piece differs" lines.
+ * @param filename Saved game to start from
+ * @param num_ticks Number of ticks to run
+ * @return 1 if both runs gave the same state after every tick, 0 if they differ or the saved game could not be loaded
+ */
+int game_hash_trace_check_determinism(const char *filename, int num_ticks);
+
+/**
+ * Runs ticks from a saved game, saves the game and then compares the state hashes of the game that
+ * keeps running with the ones of the game loaded from that save, after every tick. Saving in the middle
+ * of a daily pass that is spread over several ticks checks that its progress is saved.
+ * The first differing pieces are printed to the standard output as "tick piece differs" lines.
+ * @param filename Saved game to start from
+ * @param save_ticks Number of ticks to run before saving
+ * @param num_ticks Number of ticks to compare after saving
+ * @return 1 if both games had the same state after every tick, 0 if they differ or a game could not be loaded or saved
+ */
+int game_hash_trace_check_save_reload(const char *filename, int save_ticks, int num_ticks);
+
+#endif // GAME_HASH_TRACE_H
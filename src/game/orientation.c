@@ -3,6 +3,7 @@
 #include "city/view.h"
 #include "city/warning.h"
 #include "core/direction.h"
+#include "game/replay.h"
 #include "map/orientation.h"
 #include "widget/minimap.h"
 
@@ -10,6 +11,7 @@ static int warning_slot;
 
 void game_orientation_rotate_left(void)
 {
+    game_replay_record_command(REPLAY_COMMAND_ROTATE_LEFT, 0, 0);
     city_view_rotate_left();
     map_orientation_change(0);
     widget_minimap_invalidate();
@@ -18,6 +20,7 @@ void game_orientation_rotate_left(void)
 
 void game_orientation_rotate_right(void)
 {
+    game_replay_record_command(REPLAY_COMMAND_ROTATE_RIGHT, 0, 0);
     city_view_rotate_right();
     map_orientation_change(1);
     widget_minimap_invalidate();
@@ -26,6 +29,7 @@ void game_orientation_rotate_right(void)
 
 void game_orientation_rotate_north(void)
 {
+    game_replay_record_command(REPLAY_COMMAND_ROTATE_NORTH, 0, 0);
     switch (city_view_orientation()) {
         case DIR_2_RIGHT:
             city_view_rotate_right();
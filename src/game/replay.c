@@ -0,0 +1,285 @@
+#include "replay.h"
+
+#include "building/construction.h"
+#include "building/menu.h"
+#include "building/rotation.h"
+#include "city/finance.h"
+#include "city/labor.h"
+#include "city/resource.h"
+#include "core/buffer.h"
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "empire/city.h"
+#include "game/file.h"
+#include "game/hash_trace.h"
+#include "game/orientation.h"
+#include "game/tick.h"
+#include "game/undo.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_SAVE_FILE "replay.svx"
+#define REPLAY_LOG_FILE "replay.rpl"
+
+#define REPLAY_LOG_VERSION 2
+#define REPLAY_MAX_PARAMETERS 8
+#define REPLAY_HEADER_SIZE 8
+#define REPLAY_RECORD_SIZE (4 * (2 + REPLAY_MAX_PARAMETERS))
+
+static const char REPLAY_MAGIC[4] = { 'A', 'R', 'P', 'L' };
+
+typedef struct {
+    int tick;
+    replay_command command;
+    int params[REPLAY_MAX_PARAMETERS];
+} replay_record;
+
+static struct {
+    int recording_enabled;
+    FILE *log;
+    int tick;
+} data;
+
+void game_replay_enable_recording(void)
+{
+    data.recording_enabled = 1;
+}
+
+static void stop_recording(void)
+{
+    if (data.log) {
+        file_close(data.log);
+        data.log = 0;
+    }
+}
+
+void game_replay_start_recording(void)
+{
+    if (!data.recording_enabled) {
+        return;
+    }
+    stop_recording();
+    data.tick = 0;
+    if (!game_file_write_saved_game(dir_append_location(REPLAY_SAVE_FILE, PATH_LOCATION_SAVEGAME))) {
+        log_error("Unable to save the start of the replay", REPLAY_SAVE_FILE, 0);
+        return;
+    }
+    data.log = file_open(dir_append_location(REPLAY_LOG_FILE, PATH_LOCATION_SAVEGAME), "wb");
+    if (!data.log) {
+        log_error("Unable to create the replay log", REPLAY_LOG_FILE, 0);
+        return;
+    }
+    uint8_t header[REPLAY_HEADER_SIZE];
+    buffer buf;
+    buffer_init(&buf, header, REPLAY_HEADER_SIZE);
+    buffer_write_raw(&buf, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    buffer_write_i32(&buf, REPLAY_LOG_VERSION);
+    fwrite(header, 1, REPLAY_HEADER_SIZE, data.log);
+    fflush(data.log);
+}
+
+static void write_record(const replay_record *record)
+{
+    uint8_t bytes[REPLAY_RECORD_SIZE];
+    buffer buf;
+    buffer_init(&buf, bytes, REPLAY_RECORD_SIZE);
+    buffer_write_i32(&buf, record->tick);
+    buffer_write_i32(&buf, record->command);
+    for (int i = 0; i < REPLAY_MAX_PARAMETERS; i++) {
+        buffer_write_i32(&buf, record->params[i]);
+    }
+    // flushed right away so that a crash does not lose the commands that led to it
+    if (fwrite(bytes, 1, REPLAY_RECORD_SIZE, data.log) != REPLAY_RECORD_SIZE || fflush(data.log) != 0) {
+        log_error("Unable to write to the replay log, recording stopped", 0, 0);
+        stop_recording();
+    }
+}
+
+void game_replay_record_command(replay_command command, int param1, int param2)
+{
+    if (!data.log) {
+        return;
+    }
+    replay_record record;
+    memset(&record, 0, sizeof(replay_record));
+    record.tick = data.tick;
+    record.command = command;
+    record.params[0] = param1;
+    record.params[1] = param2;
+    write_record(&record);
+}
+
+void game_replay_record_unsupported(replay_unsupported_command command)
+{
+    game_replay_record_command(REPLAY_COMMAND_UNSUPPORTED, command, 0);
+}
+
+void game_replay_record_construction(int type, int x_start, int y_start, int x_end, int y_end)
+{
+    if (!data.log) {
+        return;
+    }
+    replay_record record;
+    memset(&record, 0, sizeof(replay_record));
+    record.tick = data.tick;
+    record.command = REPLAY_COMMAND_CONSTRUCT;
+    record.params[0] = type;
+    record.params[1] = x_start;
+    record.params[2] = y_start;
+    record.params[3] = x_end;
+    record.params[4] = y_end;
+    record.params[5] = building_rotation_get_rotation();
+    record.params[6] = building_rotation_get_extra_rotation();
+    record.params[7] = building_rotation_get_road_orientation();
+    write_record(&record);
+}
+
+void game_replay_advance_tick(void)
+{
+    data.tick++;
+}
+
+static replay_record *load_records(const char *log_filename, int *num_records)
+{
+    FILE *fp = file_open(log_filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < REPLAY_HEADER_SIZE) {
+        file_close(fp);
+        return 0;
+    }
+    uint8_t *bytes = malloc(size);
+    if (!bytes || fread(bytes, 1, size, fp) != (size_t) size) {
+        free(bytes);
+        file_close(fp);
+        return 0;
+    }
+    file_close(fp);
+
+    buffer buf;
+    buffer_init(&buf, bytes, (int) size);
+    char magic[sizeof(REPLAY_MAGIC)];
+    buffer_read_raw(&buf, magic, sizeof(magic));
+    int version = buffer_read_i32(&buf);
+    if (memcmp(magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 || version != REPLAY_LOG_VERSION) {
+        free(bytes);
+        return 0;
+    }
+    // a partially written last record means the game stopped while recording it: it is ignored
+    *num_records = (int) ((size - REPLAY_HEADER_SIZE) / REPLAY_RECORD_SIZE);
+    replay_record *records = malloc(sizeof(replay_record) * (*num_records + 1));
+    if (!records) {
+        free(bytes);
+        return 0;
+    }
+    for (int i = 0; i < *num_records; i++) {
+        records[i].tick = buffer_read_i32(&buf);
+        records[i].command = buffer_read_i32(&buf);
+        for (int p = 0; p < REPLAY_MAX_PARAMETERS; p++) {
+            records[i].params[p] = buffer_read_i32(&buf);
+        }
+    }
+    free(bytes);
+    return records;
+}
+
+static int apply_record(const replay_record *record)
+{
+    const int *params = record->params;
+    switch (record->command) {
+        case REPLAY_COMMAND_CONSTRUCT:
+            building_construction_set_type(params[0]);
+            building_rotation_set_rotation(params[5], params[6], params[7]);
+            building_construction_replay_place(params[1], params[2], params[3], params[4]);
+            building_construction_clear_type();
+            break;
+        case REPLAY_COMMAND_ROTATE_LEFT:
+            game_orientation_rotate_left();
+            break;
+        case REPLAY_COMMAND_ROTATE_RIGHT:
+            game_orientation_rotate_right();
+            break;
+        case REPLAY_COMMAND_ROTATE_NORTH:
+            game_orientation_rotate_north();
+            break;
+        case REPLAY_COMMAND_LABOR_PRIORITY:
+            city_labor_set_priority(params[0], params[1]);
+            break;
+        case REPLAY_COMMAND_WAGES:
+            city_labor_change_wages(params[0]);
+            break;
+        case REPLAY_COMMAND_TAXES:
+            city_finance_change_tax_percentage(params[0]);
+            break;
+        case REPLAY_COMMAND_TRADE_STATUS:
+            city_resource_cycle_trade_status(params[0], params[1]);
+            break;
+        case REPLAY_COMMAND_IMPORT_OVER:
+            city_resource_change_import_over(params[0], params[1]);
+            break;
+        case REPLAY_COMMAND_EXPORT_OVER:
+            city_resource_change_export_over(params[0], params[1]);
+            break;
+        case REPLAY_COMMAND_STOCKPILE:
+            city_resource_toggle_stockpiled(params[0]);
+            break;
+        case REPLAY_COMMAND_MOTHBALL:
+            city_resource_toggle_mothballed(params[0]);
+            break;
+        case REPLAY_COMMAND_OPEN_TRADE:
+            empire_city_open_trade(params[0], 1);
+            building_menu_update();
+            break;
+        case REPLAY_COMMAND_UNDO:
+            game_undo_perform();
+            break;
+        case REPLAY_COMMAND_UNSUPPORTED:
+            log_error("Replay reached a command that was not recorded, replay stopped", 0, params[0]);
+            return 0;
+        default:
+            // skipping it would let the replay silently diverge from the recorded game
+            log_error("Unknown replay command, replay stopped", 0, record->command);
+            return 0;
+    }
+    return 1;
+}
+
+int game_replay_run(const char *filename, const char *log_filename, int num_ticks)
+{
+    int num_records = 0;
+    replay_record *records = load_records(log_filename, &num_records);
+    if (!records) {
+        log_error("Unable to load replay commands", log_filename, 0);
+        return 0;
+    }
+    if (game_file_load_saved_game(filename) != FILE_LOAD_SUCCESS) {
+        log_error("Unable to load saved game for replay", filename, 0);
+        free(records);
+        return 0;
+    }
+    int next_record = 0;
+    data.tick = 0;
+    while (data.tick < num_ticks) {
+        while (next_record < num_records && records[next_record].tick <= data.tick) {
+            if (!apply_record(&records[next_record])) {
+                free(records);
+                return 0;
+            }
+            next_record++;
+        }
+        game_tick_run();
+    }
+    free(records);
+    if (next_record < num_records) {
+        log_info("Replay stopped before all commands were applied", 0, num_records - next_record);
+    }
+    game_hash_trace_print(num_ticks);
+    return 1;
+}
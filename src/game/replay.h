@@ -0,0 +1,86 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+/**
+ * @file
+ * Records the player commands of a game by tick, next to a save of the game at the moment
+ * the recording started, so that the game can be replayed without input afterwards.
+ */
+
+typedef enum {
+    REPLAY_COMMAND_NONE = 0,
+    REPLAY_COMMAND_CONSTRUCT = 1,
+    REPLAY_COMMAND_ROTATE_LEFT = 2,
+    REPLAY_COMMAND_ROTATE_RIGHT = 3,
+    REPLAY_COMMAND_ROTATE_NORTH = 4,
+    REPLAY_COMMAND_LABOR_PRIORITY = 5,
+    REPLAY_COMMAND_WAGES = 6,
+    REPLAY_COMMAND_TAXES = 7,
+    REPLAY_COMMAND_TRADE_STATUS = 8,
+    REPLAY_COMMAND_IMPORT_OVER = 9,
+    REPLAY_COMMAND_EXPORT_OVER = 10,
+    REPLAY_COMMAND_STOCKPILE = 11,
+    REPLAY_COMMAND_MOTHBALL = 12,
+    REPLAY_COMMAND_OPEN_TRADE = 13,
+    REPLAY_COMMAND_UNDO = 14,
+    REPLAY_COMMAND_UNSUPPORTED = 15,
+    REPLAY_COMMAND_MAX
+} replay_command;
+
+typedef enum {
+    REPLAY_UNSUPPORTED_STORAGE_SETTINGS = 1,
+    REPLAY_UNSUPPORTED_BUILDING_SETTINGS = 2,
+    REPLAY_UNSUPPORTED_FESTIVAL = 3,
+    REPLAY_UNSUPPORTED_LEGION_ORDERS = 4,
+    REPLAY_UNSUPPORTED_CONFIRMED_COMMAND = 5
+} replay_unsupported_command;
+
+/**
+ * Enables recording: from now on, every game that is started or loaded is saved to
+ * replay.svx and its commands are written to replay.rpl in the savegame directory
+ */
+void game_replay_enable_recording(void);
+
+/**
+ * Starts a new recording for the game that was just started or loaded, if recording is enabled
+ */
+void game_replay_start_recording(void);
+
+/**
+ * Records a player command at the current tick
+ * @param command Command to record
+ * @param param1 First parameter of the command
+ * @param param2 Second parameter of the command
+ */
+void game_replay_record_command(replay_command command, int param1, int param2);
+
+/**
+ * Records that the player gave a command that cannot be replayed yet, so that a replay
+ * stops there instead of silently diverging from the recorded game
+ * @param command Kind of command that was given
+ */
+void game_replay_record_unsupported(replay_unsupported_command command);
+
+/**
+ * Records the placement of the building currently under construction at the current tick,
+ * along with the rotation it was placed with
+ */
+void game_replay_record_construction(int type, int x_start, int y_start, int x_end, int y_end);
+
+/**
+ * Advances the tick counter of the recording, called once per game tick
+ */
+void game_replay_advance_tick(void);
+
+/**
+ * Loads a saved game and runs it for the given number of ticks while re-applying the recorded commands,
+ * then prints the hash of every saved game piece like the hash trace does
+ * @param filename Saved game the recording started from
+ * @param log_filename Recorded commands
+ * @param num_ticks Number of ticks to run
+ * @return 1 if the replay completed, 0 if the saved game or the commands could not be loaded,
+ *         or if a command is unknown to this version or was marked as unsupported when recording
+ */
+int game_replay_run(const char *filename, const char *log_filename, int num_ticks);
+
+#endif // GAME_REPLAY_H
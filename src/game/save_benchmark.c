@@ -0,0 +1,93 @@
+#include "save_benchmark.h"
+
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "game/file.h"
+#include "game/file_io.h"
+#include "game/system.h"
+
+#include <stdio.h>
+
+#define SAVE_BENCHMARK_FILE "save-benchmark.svx"
+
+static double megabytes_per_second(uint64_t bytes, uint64_t microseconds)
+{
+    return microseconds ? (double) bytes / microseconds : 0.0;
+}
+
+static double ratio(uint64_t uncompressed_bytes, uint64_t compressed_bytes)
+{
+    return compressed_bytes ? (double) uncompressed_bytes / compressed_bytes : 0.0;
+}
+
+static void print_codec(const char *name, const file_io_codec_stats *stats, int rounds)
+{
+    printf("%-28s %6d %10llu %10llu %7.2f %9.1f %11.1f\n", name, stats->pieces,
+        (unsigned long long) stats->uncompressed_bytes, (unsigned long long) stats->compressed_bytes,
+        ratio(stats->uncompressed_bytes, stats->compressed_bytes),
+        megabytes_per_second(stats->uncompressed_bytes * rounds, stats->compress_microseconds),
+        megabytes_per_second(stats->uncompressed_bytes * rounds, stats->decompress_microseconds));
+}
+
+static long get_file_size(const char *filename)
+{
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    file_close(fp);
+    return size;
+}
+
+int game_save_benchmark_run(const char *filename, int rounds)
+{
+    if (rounds < 1) {
+        rounds = 1;
+    }
+    if (game_file_load_saved_game(filename) != FILE_LOAD_SUCCESS) {
+        log_error("Unable to load saved game for save benchmark", filename, 0);
+        return 0;
+    }
+    file_io_codec_benchmark codecs;
+    game_file_io_measure_codecs(&codecs, rounds);
+
+    char save_filename[FILE_NAME_MAX];
+    snprintf(save_filename, FILE_NAME_MAX, "%s", dir_append_location(SAVE_BENCHMARK_FILE, PATH_LOCATION_SAVEGAME));
+    // all saves come first, so every one of them writes the state as it was loaded
+    uint64_t start = system_get_microseconds();
+    for (int i = 0; i < rounds; i++) {
+        if (!game_file_io_write_saved_game(save_filename)) {
+            log_error("Unable to write saved game for save benchmark", save_filename, 0);
+            return 0;
+        }
+    }
+    uint64_t save_microseconds = (system_get_microseconds() - start) / rounds;
+    long file_size = get_file_size(save_filename);
+    start = system_get_microseconds();
+    for (int i = 0; i < rounds; i++) {
+        if (game_file_io_read_saved_game(save_filename, 0) != FILE_LOAD_SUCCESS) {
+            log_error("Unable to load saved game for save benchmark", save_filename, 0);
+            game_file_delete_saved_game(save_filename);
+            return 0;
+        }
+    }
+    uint64_t load_microseconds = (system_get_microseconds() - start) / rounds;
+    game_file_delete_saved_game(save_filename);
+
+    printf("state: %llu bytes in %d pieces\n", (unsigned long long) codecs.state_bytes, codecs.pieces);
+    printf("%-28s %6s %10s %10s %7s %9s %11s\n", "codec, one thread", "pieces", "bytes in", "bytes out",
+        "ratio", "comp MB/s", "decomp MB/s");
+    print_codec("zlib", &codecs.zlib, rounds);
+    print_codec("delta-rle", &codecs.delta_rle, rounds);
+    print_codec("zlib on the delta-rle pieces", &codecs.zlib_on_delta_rle_pieces, rounds);
+    printf("file: %ld bytes, ratio %.2f\n", file_size, ratio(codecs.state_bytes, file_size));
+    printf("save: %.2f ms, %.1f MB/s of state over %d rounds\n", save_microseconds / 1000.0,
+        megabytes_per_second(codecs.state_bytes, save_microseconds), rounds);
+    printf("load: %.2f ms, %.1f MB/s of state over %d rounds\n", load_microseconds / 1000.0,
+        megabytes_per_second(codecs.state_bytes, load_microseconds), rounds);
+    fflush(stdout);
+    return 1;
+}
@@ -0,0 +1,19 @@
+#ifndef GAME_SAVE_BENCHMARK_H
+#define GAME_SAVE_BENCHMARK_H
+
+/**
+ * @file
+ * Measures how small and how fast saved games are written and read, without a window.
+ */
+
+/**
+ * Loads a saved game and prints to the standard output how well and how fast each piece codec compresses
+ * the game state, the size of the saved game compared to the state and the average save and load times,
+ * measured over the given number of rounds
+ * @param filename Saved game to measure
+ * @param rounds Number of times to compress every piece and to write and read the saved game
+ * @return 1 if the benchmark completed, 0 if a saved game could not be loaded or written
+ */
+int game_save_benchmark_run(const char *filename, int rounds);
+
+#endif // GAME_SAVE_BENCHMARK_H
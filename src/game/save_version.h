@@ -2,7 +2,7 @@
 #define GAME_SAVE_VERSION_H
 
 typedef enum {
-    SAVE_GAME_CURRENT_VERSION = 0xa0,
+    SAVE_GAME_CURRENT_VERSION = 0xa6,
 
     SAVE_GAME_LAST_ORIGINAL_LIMITS_VERSION = 0x66,
     SAVE_GAME_LAST_SMALLER_IMAGE_ID_VERSION = 0x76,
@@ -42,7 +42,13 @@ typedef enum {
     SAVE_GAME_LAST_NO_CUSTOM_EMPIRE_MAP_IMAGE = 0x9c,
     SAVE_GAME_LAST_NO_CUSTOM_CAMPAIGNS = 0x9d,
     SAVE_GAME_LAST_STATIC_SCENARIO_ORIGINAL_DATA = 0x9e,
-    SAVE_GAME_LAST_NO_LATRINES = 0x9f
+    SAVE_GAME_LAST_NO_LATRINES = 0x9f,
+    SAVE_GAME_LAST_NO_FILE_INFO_HEADER = 0xa0,
+    SAVE_GAME_LAST_NO_PIECE_CODECS = 0xa1,
+    SAVE_GAME_LAST_UNFILTERED_GRIDS = 0xa2,
+    SAVE_GAME_LAST_NO_DELTA_SAVES = 0xa3,
+    SAVE_GAME_LAST_NO_RANDOM_POOL = 0xa4,
+    SAVE_GAME_LAST_NO_SLICED_PASSES = 0xa5
 } savegame_version_t;
 
 typedef enum {
@@ -0,0 +1,37 @@
+#include "sliced_pass.h"
+
+void sliced_pass_run(sliced_pass *pass, int tick)
+{
+    if (tick < pass->start_tick || tick > pass->publish_tick) {
+        return;
+    }
+    if (tick == pass->start_tick) {
+        pass->num_items = pass->start();
+        pass->next_item = 0;
+        pass->in_progress = 1;
+    } else if (!pass->in_progress) {
+        if (tick == pass->publish_tick) {
+            pass->process(0, pass->start());
+            pass->publish();
+        }
+        return;
+    }
+    // split what is left evenly over the remaining ticks
+    int ticks_left = pass->publish_tick - tick + 1;
+    int items = (pass->num_items - pass->next_item + ticks_left - 1) / ticks_left;
+    if (items > 0) {
+        pass->process(pass->next_item, pass->next_item + items);
+        pass->next_item += items;
+    }
+    if (tick == pass->publish_tick) {
+        pass->publish();
+        pass->in_progress = 0;
+    }
+}
+
+void sliced_pass_reset(sliced_pass *pass)
+{
+    pass->in_progress = 0;
+    pass->num_items = 0;
+    pass->next_item = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef GAME_SLICED_PASS_H
+#define GAME_SLICED_PASS_H
+
+/**
+ * @file
+ * Daily passes over the whole city that are spread over several ticks.
+ * The pass works on its own copy of the results, which are published all at once in its last tick,
+ * so the rest of the game only ever sees complete results.
+ */
+
+typedef struct {
+    /** First tick of the day the pass runs in */
+    int start_tick;
+    /** Tick of the day the results are published in, never before start_tick */
+    int publish_tick;
+    /** Prepares a new pass and returns the number of items it processes */
+    int (*start)(void);
+    /** Processes the items from first up to, but not including, last */
+    void (*process)(int first, int last);
+    /** Makes the results of the pass visible to the rest of the game */
+    void (*publish)(void);
+    int in_progress;
+    int num_items;
+    int next_item;
+} sliced_pass;
+
+/**
+ * Runs the part of the pass that belongs to this tick.
+ * When the start of the pass was missed, for example because a game saved without the progress was loaded halfway,
+ * the whole pass is run in the publish tick.
+ * @param pass Pass to run
+ * @param tick Current tick of the day
+ */
+void sliced_pass_run(sliced_pass *pass, int tick);
+
+/**
+ * Drops the progress of the pass, to be called when another game is started or loaded
+ * @param pass Pass to reset
+ */
+void sliced_pass_reset(sliced_pass *pass);
+
+#endif // GAME_SLICED_PASS_H
@@ -1,13 +1,17 @@
 #include "game/speed.h"
 
 #include "building/construction.h"
+#include "core/calc.h"
 #include "core/time.h"
 #include "game/settings.h"
 #include "game/state.h"
+#include "game/system.h"
 #include "graphics/window.h"
 #include "input/scroll.h"
 
 #define MAX_TICKS_PER_FRAME 20
+#define TICK_BUDGET_MILLIS 10
+#define ACTUAL_SPEED_INTERVAL_MILLIS 1000
 
 static const time_millis MILLIS_PER_TICK_PER_SPEED[] = {
     702, 502, 352, 242, 162, 112, 82, 57, 37, 22, 16
@@ -19,7 +23,31 @@ static const time_millis MILLIS_PER_HYPER_SPEED[] = {
 static struct {
     int last_check_was_valid;
     time_millis last_update;
-} data;
+    int postponed_ticks;
+    uint64_t ticks_start;
+    struct {
+        time_millis start;
+        int ticks_requested;
+        int ticks_run;
+        int percentage;
+    } actual;
+} data = { .actual.percentage = 100 };
+
+static void update_actual_speed(time_millis now, int ticks_requested)
+{
+    data.actual.ticks_requested += ticks_requested;
+    if (now - data.actual.start < ACTUAL_SPEED_INTERVAL_MILLIS) {
+        return;
+    }
+    if (data.actual.ticks_requested && data.actual.ticks_run < data.actual.ticks_requested) {
+        data.actual.percentage = calc_percentage(data.actual.ticks_run, data.actual.ticks_requested);
+    } else {
+        data.actual.percentage = 100;
+    }
+    data.actual.start = now;
+    data.actual.ticks_requested = 0;
+    data.actual.ticks_run = 0;
+}
 
 int game_speed_get_elapsed_ticks(void)
 {
@@ -65,12 +93,22 @@ int game_speed_get_elapsed_ticks(void)
     time_millis now = time_get_millis();
     time_millis diff = now - data.last_update;
     data.last_check_was_valid = 1;
+    data.ticks_start = system_get_ticks();
     if (!last_check_was_valid) {
         // returning to map from another window or pause: always force a tick
         data.last_update = now;
+        data.postponed_ticks = 0;
+        data.actual.start = now;
+        data.actual.ticks_requested = 0;
+        data.actual.ticks_run = 0;
+        update_actual_speed(now, 1);
         return 1;
     }
     int ticks = diff / millis_per_tick;
+    update_actual_speed(now, ticks);
+    // ticks that did not fit in the budget of the previous frames are run first
+    ticks += data.postponed_ticks;
+    data.postponed_ticks = 0;
     if (!ticks) {
         return 0;
     } else if (ticks <= MAX_TICKS_PER_FRAME) {
@@ -81,3 +119,19 @@ int game_speed_get_elapsed_ticks(void)
         return MAX_TICKS_PER_FRAME;
     }
 }
+
+int game_speed_tick_budget_exhausted(void)
+{
+    return system_get_ticks() - data.ticks_start >= TICK_BUDGET_MILLIS;
+}
+
+void game_speed_set_ticks_run(int ticks_run, int ticks_due)
+{
+    data.actual.ticks_run += ticks_run;
+    data.postponed_ticks = ticks_due - ticks_run;
+}
+
+int game_speed_get_actual_speed(void)
+{
+    return calc_adjust_with_percentage(setting_game_speed(), data.actual.percentage);
+}
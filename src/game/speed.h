@@ -1,6 +1,31 @@
 #ifndef GAME_SPEED_H
 #define GAME_SPEED_H
 
+/**
+ * Gets the number of ticks to run this frame, including the ticks postponed from previous frames
+ * @return Number of ticks to run
+ */
 int game_speed_get_elapsed_ticks(void);
 
+/**
+ * Checks whether the ticks run this frame have used up the time reserved for them
+ * @return 1 if the remaining ticks should be postponed to the next frame, 0 otherwise
+ */
+int game_speed_tick_budget_exhausted(void);
+
+/**
+ * Reports how many of the ticks returned by game_speed_get_elapsed_ticks were run,
+ * the others are run in the next frames
+ * @param ticks_run Ticks that were run
+ * @param ticks_due Ticks that had to be run
+ */
+void game_speed_set_ticks_run(int ticks_run, int ticks_due);
+
+/**
+ * Gets the game speed that was actually reached over the last second,
+ * which is lower than the game speed setting when the ticks take too long to run
+ * @return Actual game speed
+ */
+int game_speed_get_actual_speed(void);
+
 #endif // GAME_SPEED_H
@@ -33,6 +33,12 @@ const char *system_OS(void);
  */
 uint64_t system_get_ticks(void);
 
+/**
+ * Gets a high resolution timestamp in microseconds, only meant to measure durations
+ * @return Timestamp in microseconds
+ */
+uint64_t system_get_microseconds(void);
+
 /**
  * Resize window
  * @param width New width
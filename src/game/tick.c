@@ -33,6 +33,7 @@
 #include "city/victory.h"
 #include "core/config.h"
 #include "core/dir.h"
+#include "core/file.h"
 #include "core/random.h"
 #include "editor/editor.h"
 #include "empire/city.h"
@@ -40,8 +41,10 @@
 #include "figuretype/crime.h"
 #include "game/file.h"
 #include "game/settings.h"
+#include "game/sliced_pass.h"
 #include "game/time.h"
 #include "game/tutorial.h"
+#include "game/replay.h"
 #include "game/undo.h"
 #include "map/desirability.h"
 #include "map/natives.h"
@@ -63,6 +66,15 @@
 #include "sound/music.h"
 #include "widget/minimap.h"
 
+#include <stdio.h>
+
+// whole city passes that are spread over the ticks before the one their results are needed in
+static sliced_pass sliced_passes[] = {
+    { 26, 37, map_desirability_start_update, map_desirability_update_part, map_desirability_finish_update },
+};
+
+#define NUM_SLICED_PASSES (sizeof(sliced_passes) / sizeof(sliced_pass))
+
 static void advance_year(void)
 {
     game_undo_disable();
@@ -75,6 +87,22 @@ static void advance_year(void)
     city_ratings_update(1,0);
 }
 
+static void write_monthly_autosave(void)
+{
+    if (!config_get(CONFIG_GENERAL_DELTA_AUTOSAVES)) {
+        game_file_write_autosave(dir_append_location("autosave.svx", PATH_LOCATION_SAVEGAME));
+        return;
+    }
+    char checkpoint_filename[FILE_NAME_MAX];
+    char alternate_checkpoint_filename[FILE_NAME_MAX];
+    snprintf(checkpoint_filename, FILE_NAME_MAX, "%s",
+        dir_append_location("autosave-checkpoint.svx", PATH_LOCATION_SAVEGAME));
+    snprintf(alternate_checkpoint_filename, FILE_NAME_MAX, "%s",
+        dir_append_location("autosave-checkpoint-2.svx", PATH_LOCATION_SAVEGAME));
+    game_file_write_delta_saved_game(dir_append_location("autosave.svx", PATH_LOCATION_SAVEGAME),
+        checkpoint_filename, alternate_checkpoint_filename);
+}
+
 static void advance_month(void)
 {
     int new_year = 0;
@@ -96,10 +124,15 @@ static void advance_month(void)
     building_industry_start_strikes();
     building_trim();
 
+#ifdef FULL_MONTHLY_TILE_UPDATE
     building_connectable_update_connections();
     map_tiles_update_all_roads();
     map_tiles_update_all_highways();
     map_tiles_update_all_water();
+#else
+    building_connectable_update_marked_connections();
+    map_tiles_update_marked();
+#endif
     map_routing_update_land_citizen();
     city_message_sort_and_compact();
 
@@ -118,10 +151,10 @@ static void advance_month(void)
     scenario_events_progress_paused(1);
     scenario_events_process_all();
     if (setting_monthly_autosave()) {
-        game_file_write_saved_game(dir_append_location("autosave.svx", PATH_LOCATION_SAVEGAME));
+        write_monthly_autosave();
     }
     if (new_year && config_get(CONFIG_GP_CH_YEARLY_AUTOSAVE)) {
-        game_file_write_saved_game(dir_append_location("autosave-year.svx", PATH_LOCATION_SAVEGAME));
+        game_file_write_autosave(dir_append_location("autosave-year.svx", PATH_LOCATION_SAVEGAME));
     }
 }
 
@@ -141,8 +174,11 @@ static void advance_day(void)
 
 static void advance_tick(void)
 {
+    for (int i = 0; i < NUM_SLICED_PASSES; i++) {
+        sliced_pass_run(&sliced_passes[i], game_time_tick());
+    }
     // NB: these ticks are noop:
-    // 0, 10, 11, 13, 14, 15, 18, 26, 41
+    // 0, 10, 11, 13, 14, 15, 18, 41
     // max is 49
     switch (game_time_tick()) {
         case 1: city_gods_calculate_moods(1); break;
@@ -174,7 +210,6 @@ static void advance_tick(void)
         case 34: building_government_distribute_treasury(); break;
         case 35: house_service_decay_culture(); break;
         case 36: house_service_calculate_culture_aggregates(); break;
-        case 37: map_desirability_update(); break;
         case 38: building_update_desirability(); break;
         case 39: building_house_process_evolve_and_consume_goods(); break;
         case 40: building_update_state(); break;
@@ -202,11 +237,43 @@ void game_tick_run(void)
     random_generate_next();
     game_undo_reduce_time_available();
     advance_tick();
+    map_routing_update_land_dirty();
     figure_action_handle();
     scenario_earthquake_process();
     scenario_gladiator_revolt_process();
     scenario_emperor_change_process();
     city_victory_check();
+    game_replay_advance_tick();
+}
+
+void game_tick_reset(void)
+{
+    for (int i = 0; i < NUM_SLICED_PASSES; i++) {
+        sliced_pass_reset(&sliced_passes[i]);
+    }
+    map_desirability_clear_update();
+}
+
+void game_tick_save_state(buffer *passes, buffer *desirability_update)
+{
+    for (int i = 0; i < NUM_SLICED_PASSES; i++) {
+        const sliced_pass *pass = &sliced_passes[i];
+        buffer_write_i32(passes, pass->in_progress);
+        buffer_write_i32(passes, pass->num_items);
+        buffer_write_i32(passes, pass->next_item);
+    }
+    map_desirability_save_update_state(desirability_update);
+}
+
+void game_tick_load_state(buffer *passes, buffer *desirability_update)
+{
+    for (int i = 0; i < NUM_SLICED_PASSES; i++) {
+        sliced_pass *pass = &sliced_passes[i];
+        pass->in_progress = buffer_read_i32(passes);
+        pass->num_items = buffer_read_i32(passes);
+        pass->next_item = buffer_read_i32(passes);
+    }
+    map_desirability_load_update_state(desirability_update);
 }
 
 void game_tick_cheat_year(void)
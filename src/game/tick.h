@@ -1,8 +1,30 @@
 #ifndef GAME_TICK_H
 #define GAME_TICK_H
 
+#include "core/buffer.h"
+
 void game_tick_run(void);
 
+/**
+ * Drops the progress of the daily passes that are spread over several ticks,
+ * called when a game is started or a game saved without that progress is loaded
+ */
+void game_tick_reset(void);
+
+/**
+ * Saves the progress of the daily passes that are spread over several ticks, together with their pending results
+ * @param passes Buffer to save the progress to
+ * @param desirability_update Buffer to save the pending desirability update to
+ */
+void game_tick_save_state(buffer *passes, buffer *desirability_update);
+
+/**
+ * Loads the progress of the daily passes that are spread over several ticks, together with their pending results
+ * @param passes Buffer to read the progress from
+ * @param desirability_update Buffer to read the pending desirability update from
+ */
+void game_tick_load_state(buffer *passes, buffer *desirability_update);
+
 void game_tick_cheat_year(void);
 
 #endif // GAME_TICK_H
@@ -12,15 +12,16 @@
 #include "building/storage.h"
 #include "city/buildings.h"
 #include "city/finance.h"
+#include "core/buffer.h"
 #include "core/calc.h"
+#include "core/config.h"
 #include "core/image.h"
 #include "figure/roamer_preview.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "graphics/window.h"
 #include "map/aqueduct.h"
-#include "map/building.h"
 #include "map/building_tiles.h"
-#include "map/grid.h"
 #include "map/image.h"
 #include "map/property.h"
 #include "map/routing_terrain.h"
@@ -28,28 +29,80 @@
 #include "map/terrain.h"
 #include "scenario/earthquake.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define MAX_UNDO_BUILDINGS 50
+#define MAX_UNDO_RECORDS 100
+#define UNDO_TIMEOUT_TICKS 500
+#define BYTES_PER_MEGABYTE (1024 * 1024)
+
+typedef struct {
+    building_type type;
+    int building_cost;
+    int timeout_ticks;
+    int num_buildings;
+    building *buildings;
+    uint8_t *map_data;
+    int map_data_size;
+} undo_record;
 
 static struct {
     int available;
     int ready;
-    int timeout_ticks;
     int building_cost;
     int num_buildings;
     building_type type;
     building buildings[MAX_UNDO_BUILDINGS];
+    struct {
+        undo_record records[MAX_UNDO_RECORDS];
+        int first;
+        int count;
+        int total_size;
+    } history;
 } data;
 
+static undo_record *history_record(int index)
+{
+    return &data.history.records[(data.history.first + index) % MAX_UNDO_RECORDS];
+}
+
+static int record_size(const undo_record *record)
+{
+    return record->map_data_size + record->num_buildings * (int) sizeof(building);
+}
+
+static void free_record(undo_record *record)
+{
+    data.history.total_size -= record_size(record);
+    free(record->buildings);
+    free(record->map_data);
+    memset(record, 0, sizeof(undo_record));
+}
+
+static void drop_oldest_records(int num_records)
+{
+    for (int i = 0; i < num_records && data.history.count > 0; i++) {
+        free_record(history_record(0));
+        data.history.first = (data.history.first + 1) % MAX_UNDO_RECORDS;
+        data.history.count--;
+    }
+}
+
+static void clear_history(void)
+{
+    drop_oldest_records(data.history.count);
+}
+
 int game_can_undo(void)
 {
-    return data.ready && data.available;
+    return data.ready && data.history.count > 0;
 }
 
 void game_undo_disable(void)
 {
     data.available = 0;
+    clear_history();
 }
 
 void game_undo_add_building(building *b)
@@ -94,12 +147,12 @@ int game_undo_contains_building(int building_id)
     if (building_id <= 0 || !game_can_undo()) {
         return 0;
     }
-    if (data.num_buildings <= 0) {
-        return 0;
-    }
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
-        if (data.buildings[i].id == building_id) {
-            return 1;
+    for (int i = 0; i < data.history.count; i++) {
+        const undo_record *record = history_record(i);
+        for (int j = 0; j < record->num_buildings; j++) {
+            if (record->buildings[j].id == building_id) {
+                return 1;
+            }
         }
     }
     return 0;
@@ -115,7 +168,6 @@ int game_undo_start_build(building_type type)
 {
     data.ready = 0;
     data.available = 1;
-    data.timeout_ticks = 0;
     data.building_cost = 0;
     data.type = type;
     clear_buildings();
@@ -153,35 +205,97 @@ void game_undo_restore_building_state(void)
     clear_buildings();
 }
 
-static void restore_map_images(void)
+void game_undo_restore_map(int include_properties)
+{
+    map_terrain_restore();
+    map_aqueduct_restore();
+    if (include_properties) {
+        map_property_restore();
+    }
+    map_image_restore_except_buildings();
+}
+
+static int add_record(void)
 {
-    int map_width, map_height;
-    map_grid_size(&map_width, &map_height);
-    for (int y = 0; y < map_height; y++) {
-        for (int x = 0; x < map_width; x++) {
-            int grid_offset = map_grid_offset(x, y);
-            if (!map_building_at(grid_offset)) {
-                map_image_restore_at(grid_offset);
+    undo_record record;
+    memset(&record, 0, sizeof(undo_record));
+    record.type = data.type;
+    record.building_cost = data.building_cost;
+    record.timeout_ticks = UNDO_TIMEOUT_TICKS;
+    record.map_data_size = map_terrain_backup_size() + map_aqueduct_backup_size() +
+        map_property_backup_size() + map_sprite_backup_size() + map_image_backup_size();
+    record.map_data = malloc(record.map_data_size);
+    if (!record.map_data) {
+        return 0;
+    }
+    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+        if (data.buildings[i].id) {
+            record.num_buildings++;
+        }
+    }
+    if (record.num_buildings) {
+        record.buildings = malloc(record.num_buildings * sizeof(building));
+        if (!record.buildings) {
+            free(record.map_data);
+            return 0;
+        }
+        int index = 0;
+        for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+            if (data.buildings[i].id) {
+                memcpy(&record.buildings[index++], &data.buildings[i], sizeof(building));
             }
         }
     }
+    buffer buf;
+    buffer_init(&buf, record.map_data, record.map_data_size);
+    map_terrain_save_backup(&buf);
+    map_aqueduct_save_backup(&buf);
+    map_property_save_backup(&buf);
+    map_sprite_save_backup(&buf);
+    map_image_save_backup(&buf);
+
+    if (data.history.count == MAX_UNDO_RECORDS) {
+        drop_oldest_records(1);
+    }
+    *history_record(data.history.count) = record;
+    data.history.count++;
+    data.history.total_size += record_size(&record);
+
+    // the most recent construction can always be undone, older ones only while they fit in the budget
+    int budget = config_get(CONFIG_GENERAL_UNDO_HISTORY_MEMORY) * BYTES_PER_MEGABYTE;
+    while (data.history.count > 1 && data.history.total_size > budget) {
+        drop_oldest_records(1);
+    }
+    return 1;
 }
 
-void game_undo_restore_map(int include_properties)
+static void load_record(const undo_record *record)
 {
-    map_terrain_restore();
-    map_aqueduct_restore();
-    if (include_properties) {
-        map_property_restore();
+    data.type = record->type;
+    data.building_cost = record->building_cost;
+    clear_buildings();
+    if (record->num_buildings) {
+        memcpy(data.buildings, record->buildings, record->num_buildings * sizeof(building));
     }
-    restore_map_images();
+    data.num_buildings = record->num_buildings;
+
+    buffer buf;
+    buffer_init(&buf, record->map_data, record->map_data_size);
+    map_terrain_load_backup(&buf);
+    map_aqueduct_load_backup(&buf);
+    map_property_load_backup(&buf);
+    map_sprite_load_backup(&buf);
+    map_image_load_backup(&buf);
 }
 
 void game_undo_finish_build(int cost)
 {
     data.ready = 1;
-    data.timeout_ticks = 500;
     data.building_cost = cost;
+    if (!data.available || !add_record()) {
+        // older constructions cannot be undone past one that cannot be undone
+        clear_history();
+    }
     window_invalidate();
 }
 
@@ -211,7 +325,11 @@ void game_undo_perform(void)
     if (!game_can_undo()) {
         return;
     }
-    data.available = 0;
+    game_replay_record_command(REPLAY_COMMAND_UNDO, 0, 0);
+    load_record(history_record(data.history.count - 1));
+    free_record(history_record(data.history.count - 1));
+    data.history.count--;
+
     city_finance_process_construction(-data.building_cost);
     if (data.type == BUILDING_CLEAR_LAND) {
         for (int i = 0; i < data.num_buildings; i++) {
@@ -251,22 +369,22 @@ void game_undo_perform(void)
         data.type == BUILDING_WALL || data.type == BUILDING_HIGHWAY) {
         map_terrain_restore();
         map_aqueduct_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.type == BUILDING_LOW_BRIDGE || data.type == BUILDING_SHIP_BRIDGE) {
         map_terrain_restore();
         map_sprite_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.type == BUILDING_PLAZA || data.type == BUILDING_GARDENS ||
         data.type == BUILDING_OVERGROWN_GARDENS) {
         map_terrain_restore();
         map_aqueduct_restore();
         map_property_restore();
-        restore_map_images();
+        map_image_restore_except_buildings();
     } else if (data.num_buildings) {
         if (data.type == BUILDING_DRAGGABLE_RESERVOIR) {
             map_terrain_restore();
             map_aqueduct_restore();
-            restore_map_images();
+            map_image_restore_except_buildings();
         }
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
@@ -281,19 +399,13 @@ void game_undo_perform(void)
     data.num_buildings = 0;
 }
 
-void game_undo_reduce_time_available(void)
+static int reduce_record_time_available(undo_record *record)
 {
-    if (!game_can_undo()) {
-        return;
-    }
-    if (data.timeout_ticks <= 0 || scenario_earthquake_is_in_progress()) {
-        data.available = 0;
-        clear_buildings();
-        window_invalidate();
-        return;
+    if (record->timeout_ticks <= 0) {
+        return 0;
     }
-    data.timeout_ticks--;
-    switch (data.type) {
+    record->timeout_ticks--;
+    switch (record->type) {
         case BUILDING_CLEAR_LAND:
         case BUILDING_AQUEDUCT:
         case BUILDING_ROAD:
@@ -304,39 +416,52 @@ void game_undo_reduce_time_available(void)
         case BUILDING_PLAZA:
         case BUILDING_GARDENS:
         case BUILDING_OVERGROWN_GARDENS:
-            return;
+            return 1;
         default: break;
     }
-    if (data.num_buildings <= 0) {
-        data.available = 0;
-        window_invalidate();
-        return;
+    if (record->num_buildings <= 0) {
+        return 0;
     }
-    if (data.type == BUILDING_HOUSE_VACANT_LOT) {
-        for (int i = 0; i < data.num_buildings; i++) {
-            if (data.buildings[i].id && building_get(data.buildings[i].id)->house_population) {
+    if (record->type == BUILDING_HOUSE_VACANT_LOT) {
+        for (int i = 0; i < record->num_buildings; i++) {
+            if (record->buildings[i].id && building_get(record->buildings[i].id)->house_population) {
                 // no undo on a new house where people moved in
-                data.available = 0;
-                window_invalidate();
-                return;
+                return 0;
             }
         }
     }
-    for (int i = 0; i < data.num_buildings; i++) {
-        if (data.buildings[i].id) {
-            building *b = building_get(data.buildings[i].id);
+    for (int i = 0; i < record->num_buildings; i++) {
+        if (record->buildings[i].id) {
+            building *b = building_get(record->buildings[i].id);
             if (b->state == BUILDING_STATE_UNDO ||
                 b->state == BUILDING_STATE_RUBBLE ||
                 b->state == BUILDING_STATE_DELETED_BY_GAME) {
-                data.available = 0;
-                window_invalidate();
-                return;
+                return 0;
             }
-            if (b->type != data.buildings[i].type || b->grid_offset != data.buildings[i].grid_offset) {
-                data.available = 0;
-                window_invalidate();
-                return;
+            if (b->type != record->buildings[i].type || b->grid_offset != record->buildings[i].grid_offset) {
+                return 0;
             }
         }
     }
+    return 1;
+}
+
+void game_undo_reduce_time_available(void)
+{
+    if (!data.history.count) {
+        return;
+    }
+    if (scenario_earthquake_is_in_progress()) {
+        clear_history();
+        window_invalidate();
+        return;
+    }
+    for (int i = data.history.count - 1; i >= 0; i--) {
+        if (!reduce_record_time_available(history_record(i))) {
+            // a construction can only be undone after all the later ones
+            drop_oldest_records(i + 1);
+            window_invalidate();
+            return;
+        }
+    }
 }
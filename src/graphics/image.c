@@ -77,7 +77,7 @@ static void draw_multibyte_letter(font_t font, const image *img, int x, int y, c
 
 void image_draw_letter(font_t font, int letter_id, int x, int y, color_t color, float scale)
 {
-    const image *img = image_letter(letter_id);
+    const image *img = image_letter_for_drawing(letter_id);
     if (letter_id >= IMAGE_FONT_MULTIBYTE_OFFSET) {
         draw_multibyte_letter(font, img, x, y, color, scale);
         return;
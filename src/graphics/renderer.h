@@ -87,6 +87,8 @@ typedef struct {
     const image_atlas_data *(*get_image_atlas)(atlas_type type);
     int (*has_image_atlas)(atlas_type type);
     void (*free_image_atlas)(atlas_type type);
+    int (*update_image_atlas)(atlas_type type, int image_index, const color_t *pixels,
+        int x_offset, int y_offset, int width, int height);
 
     void (*load_unpacked_image)(const image *img, const color_t *pixels);
     void (*free_unpacked_image)(const image *img);
@@ -8,10 +8,13 @@
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define ELLIPSIS_LENGTH 4
 #define NUMBER_BUFFER_LENGTH 100
+#define LAYOUT_CACHE_SIZE 32
+#define LAYOUT_MAX_LINES 100
 
 static uint8_t tmp_line[200];
 
@@ -34,6 +37,45 @@ static struct {
     int width[FONT_TYPES_MAX];
 } ellipsis = { {'.', '.', '.', 0} };
 
+typedef struct {
+    int letter_id;
+    int x;
+    int y;
+} layout_glyph;
+
+typedef struct {
+    int start;
+    int length;
+    int width;
+    int first_glyph;
+    int num_glyphs;
+} layout_line;
+
+// Multiline texts are laid out once for each font and box width, since the same text is usually drawn every frame
+typedef struct {
+    int in_use;
+    uint64_t hash;
+    int length;
+    font_t font;
+    int box_width;
+    unsigned int last_used;
+    int is_laid_out;
+    int num_lines;
+    layout_line lines[LAYOUT_MAX_LINES];
+    int has_glyphs;
+    int num_glyphs;
+    int glyph_capacity;
+    layout_glyph *glyphs;
+    int is_measured;
+    int measured_lines;
+    int largest_width;
+} text_layout;
+
+static struct {
+    text_layout entries[LAYOUT_CACHE_SIZE];
+    unsigned int use_counter;
+} layout_cache;
+
 static int get_ellipsis_width(font_t font)
 {
     if (!ellipsis.width[font]) {
@@ -559,26 +601,121 @@ void text_draw_number_centered_colored(
     text_draw_centered(str, x_offset, y_offset, box_width, font, color);
 }
 
-int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
-    int centered, font_t font, color_t color)
+static uint64_t hash_string(const uint8_t *str, int *length)
 {
-    int line_height = font_definition_for(font)->line_height;
-    if (line_height < 11) {
-        line_height = 11;
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint8_t *start = str;
+    while (*str) {
+        hash ^= *str++;
+        hash *= 0x100000001b3ULL;
+    }
+    *length = (int) (str - start);
+    return hash;
+}
+
+void text_invalidate_layout_cache(void)
+{
+    for (int i = 0; i < LAYOUT_CACHE_SIZE; i++) {
+        layout_cache.entries[i].in_use = 0;
     }
+    memset(ellipsis.width, 0, sizeof(ellipsis.width));
+}
+
+static text_layout *get_layout(const uint8_t *str, font_t font, int box_width)
+{
+    int length;
+    uint64_t hash = hash_string(str, &length);
+    text_layout *oldest = &layout_cache.entries[0];
+    for (int i = 0; i < LAYOUT_CACHE_SIZE; i++) {
+        text_layout *layout = &layout_cache.entries[i];
+        if (!layout->in_use) {
+            if (oldest->in_use) {
+                oldest = layout;
+            }
+            continue;
+        }
+        if (layout->hash == hash && layout->length == length &&
+            layout->font == font && layout->box_width == box_width) {
+            layout->last_used = ++layout_cache.use_counter;
+            return layout;
+        }
+        if (oldest->in_use && layout->last_used < oldest->last_used) {
+            oldest = layout;
+        }
+    }
+    // the glyph buffer of the evicted layout is kept for the new one
+    oldest->in_use = 1;
+    oldest->hash = hash;
+    oldest->length = length;
+    oldest->font = font;
+    oldest->box_width = box_width;
+    oldest->last_used = ++layout_cache.use_counter;
+    oldest->is_laid_out = 0;
+    oldest->is_measured = 0;
+    return oldest;
+}
+
+static int add_glyph(text_layout *layout, int letter_id, int x, int y)
+{
+    if (layout->num_glyphs >= layout->glyph_capacity) {
+        int capacity = layout->glyph_capacity ? layout->glyph_capacity * 2 : 64;
+        layout_glyph *glyphs = realloc(layout->glyphs, sizeof(layout_glyph) * capacity);
+        if (!glyphs) {
+            return 0;
+        }
+        layout->glyphs = glyphs;
+        layout->glyph_capacity = capacity;
+    }
+    layout_glyph *glyph = &layout->glyphs[layout->num_glyphs++];
+    glyph->letter_id = letter_id;
+    glyph->x = x;
+    glyph->y = y;
+    return 1;
+}
+
+static void add_line_glyphs(text_layout *layout, layout_line *line, const uint8_t *str, const font_definition *def)
+{
+    // same steps as text_draw_scaled, without drawing
+    line->first_glyph = layout->num_glyphs;
+    int x = 0;
+    int length = line->length;
+    while (length > 0 && layout->has_glyphs) {
+        int num_bytes = 1;
+        if (*str >= ' ') {
+            int letter_id = font_letter_id(def, str, &num_bytes);
+            if (*str == ' ' || *str == '_' || letter_id < 0) {
+                x += def->space_width;
+            } else {
+                const image *img = image_letter(letter_id);
+                int height = def->image_y_offset(*str, img->height + img->y_offset, def->line_height);
+                layout->has_glyphs = add_glyph(layout, letter_id, x, height);
+                x += def->letter_spacing + img->original.width;
+            }
+        }
+        str += num_bytes;
+        length -= num_bytes;
+    }
+    line->num_glyphs = layout->num_glyphs - line->first_glyph;
+}
+
+static void lay_out_multiline(text_layout *layout, const uint8_t *str, int box_width, font_t font)
+{
+    const font_definition *def = font_definition_for(font);
+    const uint8_t *text = str;
+    layout->num_lines = 0;
+    layout->num_glyphs = 0;
+    layout->has_glyphs = 1;
     int has_more_characters = 1;
     int guard = 0;
-    int y = y_offset;
     while (has_more_characters) {
-        if (++guard >= 100) {
+        if (++guard >= LAYOUT_MAX_LINES) {
             break;
         }
-        // clear line
-        for (int i = 0; i < 200; i++) {
-            tmp_line[i] = 0;
-        }
+        layout_line *line = &layout->lines[layout->num_lines++];
+        line->start = 0;
+        line->length = 0;
         int current_width = 0;
-        int line_index = 0;
         while (has_more_characters) {
             int word_num_chars;
             int word_width = get_word_width(str, font, &word_num_chars, 0);
@@ -594,10 +731,14 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
             }
             current_width += word_width;
             for (int i = 0; i < word_num_chars; i++) {
-                if (line_index == 0 && *str <= ' ') {
+                if (line->length == 0 && *str <= ' ') {
                     str++; // skip whitespace at start of line
                 } else {
-                    tmp_line[line_index++] = *str++;
+                    if (line->length == 0) {
+                        line->start = (int) (str - text);
+                    }
+                    line->length++;
+                    str++;
                 }
             }
             if (!*str) {
@@ -607,14 +748,47 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
                 break;
             }
         }
-        int line_offset = centered ? (box_width - current_width) / 2 : 0;
-        text_draw(tmp_line, x_offset + line_offset, y, font, color);
+        if (line->length >= (int) sizeof(tmp_line)) {
+            line->length = sizeof(tmp_line) - 1;
+        }
+        line->width = current_width;
+        add_line_glyphs(layout, line, text + line->start, def);
+    }
+    layout->is_laid_out = 1;
+}
+
+int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
+    int centered, font_t font, color_t color)
+{
+    const font_definition *def = font_definition_for(font);
+    int line_height = def->line_height;
+    if (line_height < 11) {
+        line_height = 11;
+    }
+    text_layout *layout = get_layout(str, font, box_width);
+    if (!layout->is_laid_out) {
+        lay_out_multiline(layout, str, box_width, font);
+    }
+    int y = y_offset;
+    for (int i = 0; i < layout->num_lines; i++) {
+        const layout_line *line = &layout->lines[i];
+        int x = x_offset + (centered ? (box_width - line->width) / 2 : 0);
+        if (layout->has_glyphs) {
+            for (int g = 0; g < line->num_glyphs; g++) {
+                const layout_glyph *glyph = &layout->glyphs[line->first_glyph + g];
+                image_draw_letter(def->font, glyph->letter_id, x + glyph->x, y - glyph->y, color, SCALE_NONE);
+            }
+        } else {
+            memcpy(tmp_line, str + line->start, line->length);
+            tmp_line[line->length] = 0;
+            text_draw(tmp_line, x, y, font, color);
+        }
         y += line_height + 5;
     }
     return y - y_offset;
 }
 
-int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
+static int measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
 {
     *largest_width = 0;
     int has_more_characters = 1;
@@ -657,3 +831,14 @@ int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *
     }
     return num_lines;
 }
+
+int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width)
+{
+    text_layout *layout = get_layout(str, font, box_width);
+    if (!layout->is_measured) {
+        layout->measured_lines = measure_multiline(str, box_width, font, &layout->largest_width);
+        layout->is_measured = 1;
+    }
+    *largest_width = layout->largest_width;
+    return layout->measured_lines;
+}
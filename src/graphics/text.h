@@ -53,4 +53,9 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
  */
 int text_measure_multiline(const uint8_t *str, int box_width, font_t font, int *largest_width);
 
+/**
+ * Forgets all cached text layouts and widths, to be called when the fonts are (re)loaded
+ */
+void text_invalidate_layout_cache(void);
+
 #endif // GRAPHICS_TEXT_H
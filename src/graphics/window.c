@@ -19,6 +19,7 @@ static struct {
     int refresh_immediate;
     int refresh_on_draw;
     int underlying_windows_redrawing;
+    int invalidation_count;
 } data;
 
 static void noop(void)
@@ -57,6 +58,7 @@ void window_invalidate(void)
 {
     data.refresh_immediate = 1;
     data.refresh_on_draw = 1;
+    data.invalidation_count++;
 }
 
 int window_is_invalid(void)
@@ -64,6 +66,11 @@ int window_is_invalid(void)
     return data.refresh_immediate;
 }
 
+int window_invalidation_count(void)
+{
+    return data.invalidation_count;
+}
+
 void window_request_refresh(void)
 {
     data.refresh_on_draw = 1;
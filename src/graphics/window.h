@@ -122,6 +122,12 @@ void window_request_refresh(void);
  */
 int window_is_invalid(void);
 
+/**
+ * Returns the number of times the window has been invalidated, so that values depending on the game state
+ * can tell whether they need to be updated
+ */
+int window_invalidation_count(void);
+
 void window_draw(int force);
 
 void window_draw_underlying_window(void);
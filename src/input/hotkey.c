@@ -2,6 +2,7 @@
 
 #include "building/type.h"
 #include "city/constants.h"
+#include "core/performance.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/system.h"
@@ -35,6 +36,8 @@ typedef struct {
     int save_screenshot;
     int save_city_screenshot;
     int save_minimap_screenshot;
+    int toggle_performance_overlay;
+    int save_performance_trace;
 } global_hotkeys;
 
 static struct {
@@ -233,6 +236,12 @@ static void set_definition_for_action(hotkey_action action, hotkey_definition *d
         case HOTKEY_SAVE_MINIMAP_SCREENSHOT:
             def->action = &data.global_hotkey_state.save_minimap_screenshot;
             break;
+        case HOTKEY_TOGGLE_PERFORMANCE_OVERLAY:
+            def->action = &data.global_hotkey_state.toggle_performance_overlay;
+            break;
+        case HOTKEY_SAVE_PERFORMANCE_TRACE:
+            def->action = &data.global_hotkey_state.save_performance_trace;
+            break;
         case HOTKEY_BUILD_VACANT_HOUSE:
             def->action = &data.hotkey_state.building;
             def->value = BUILDING_HOUSE_VACANT_LOT;
@@ -665,6 +674,12 @@ void hotkey_handle_global_keys(void)
     if (data.global_hotkey_state.save_minimap_screenshot) {
         graphics_save_screenshot(SCREENSHOT_MINIMAP);
     }
+    if (data.global_hotkey_state.toggle_performance_overlay) {
+        performance_set_enabled(!performance_is_enabled());
+    }
+    if (data.global_hotkey_state.save_performance_trace) {
+        performance_save_trace();
+    }
 }
 
 void hotkey_set_value_for_action(hotkey_action action, int value)
@@ -7,6 +7,7 @@
 
 static grid_u8 aqueduct;
 static grid_u8 aqueduct_backup;
+static grid_backup_region backup_region;
 
 int map_aqueduct_has_water_access_at(int grid_offset)
 {
@@ -20,16 +21,19 @@ int map_aqueduct_image_at(int grid_offset)
 
 void map_aqueduct_set_water_access(int grid_offset, int value)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, aqueduct.items, aqueduct_backup.items);
     aqueduct.items[grid_offset] = (value << WATER_ACCESS_OFFSET) | (aqueduct.items[grid_offset] & IMAGE_MASK);
 }
 
 void map_aqueduct_set_image(int grid_offset, int value)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, aqueduct.items, aqueduct_backup.items);
     aqueduct.items[grid_offset] = (aqueduct.items[grid_offset] & ~IMAGE_MASK) | value;
 }
 
 void map_aqueduct_remove(int grid_offset)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, aqueduct.items, aqueduct_backup.items);
     aqueduct.items[grid_offset] = 0;
     if (map_aqueduct_image_at(grid_offset + map_grid_delta(0, -1)) == 5) {
         map_aqueduct_set_image(grid_offset + map_grid_delta(0, -1), 1);
@@ -47,27 +51,46 @@ void map_aqueduct_remove(int grid_offset)
 
 void map_aqueduct_clear(void)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_clear_u8(aqueduct.items);
 }
 
 void map_aqueduct_backup(void)
 {
-    map_grid_copy_u8(aqueduct.items, aqueduct_backup.items);
+    map_grid_backup_region_start(&backup_region);
 }
 
 void map_aqueduct_restore(void)
 {
-    map_grid_copy_u8(aqueduct_backup.items, aqueduct.items);
+    map_grid_backup_region_restore_u8(&backup_region, aqueduct_backup.items, aqueduct.items);
+}
+
+int map_aqueduct_backup_size(void)
+{
+    return map_grid_backup_region_saved_size(&backup_region, sizeof(aqueduct_backup.items[0]));
+}
+
+void map_aqueduct_save_backup(buffer *buf)
+{
+    map_grid_backup_region_save(&backup_region, aqueduct_backup.items, sizeof(aqueduct_backup.items[0]), buf);
+}
+
+void map_aqueduct_load_backup(buffer *buf)
+{
+    map_grid_backup_region_load(&backup_region, aqueduct_backup.items, sizeof(aqueduct_backup.items[0]), buf);
 }
 
 void map_aqueduct_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(aqueduct.items, buf);
-    map_grid_save_state_u8(aqueduct_backup.items, backup);
+    // the backup is only valid inside the region of the last construction, so the grid itself is stored
+    // to keep equal states saving equally
+    map_grid_save_state_u8(aqueduct.items, backup);
 }
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_load_state_u8(aqueduct.items, buf);
     map_grid_load_state_u8(aqueduct_backup.items, backup);
 }
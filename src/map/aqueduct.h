@@ -22,6 +22,12 @@ void map_aqueduct_backup(void);
 
 void map_aqueduct_restore(void);
 
+int map_aqueduct_backup_size(void);
+
+void map_aqueduct_save_backup(buffer *buf);
+
+void map_aqueduct_load_backup(buffer *buf);
+
 void map_aqueduct_save_state(buffer *buf, buffer *backup);
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup);
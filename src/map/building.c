@@ -8,6 +8,27 @@ static grid_u16 buildings_grid;
 static grid_u8 damage_grid;
 static grid_u8 rubble_type_grid;
 
+#define HOUSE_SERVICE_RADIUS 2
+#define MAX_HOUSES_IN_SERVICE_AREA ((2 * HOUSE_SERVICE_RADIUS + 1) * (2 * HOUSE_SERVICE_RADIUS + 1))
+
+static struct {
+    grid_u8 is_valid;
+    grid_u8 num_houses;
+    uint16_t houses[GRID_SIZE * GRID_SIZE][MAX_HOUSES_IN_SERVICE_AREA];
+} service_area;
+
+static void invalidate_service_areas_around(int grid_offset)
+{
+    for (int dy = -HOUSE_SERVICE_RADIUS; dy <= HOUSE_SERVICE_RADIUS; dy++) {
+        for (int dx = -HOUSE_SERVICE_RADIUS; dx <= HOUSE_SERVICE_RADIUS; dx++) {
+            int offset = grid_offset + map_grid_delta(dx, dy);
+            if (map_grid_is_valid_offset(offset)) {
+                service_area.is_valid.items[offset] = 0;
+            }
+        }
+    }
+}
+
 int map_building_at(int grid_offset)
 {
     return map_grid_is_valid_offset(grid_offset) ? buildings_grid.items[grid_offset] : 0;
@@ -21,7 +42,32 @@ int map_building_from_buffer(buffer *buildings, int grid_offset)
 
 void map_building_set(int grid_offset, int building_id)
 {
-    buildings_grid.items[grid_offset] = building_id;
+    if (buildings_grid.items[grid_offset] != building_id) {
+        buildings_grid.items[grid_offset] = building_id;
+        invalidate_service_areas_around(grid_offset);
+    }
+}
+
+int map_building_houses_in_service_area(int x, int y, const uint16_t **houses)
+{
+    int grid_offset = map_grid_offset(x, y);
+    if (!service_area.is_valid.items[grid_offset]) {
+        int num_houses = 0;
+        int x_min, y_min, x_max, y_max;
+        map_grid_get_area(x, y, 1, HOUSE_SERVICE_RADIUS, &x_min, &y_min, &x_max, &y_max);
+        for (int yy = y_min; yy <= y_max; yy++) {
+            for (int xx = x_min; xx <= x_max; xx++) {
+                int building_id = buildings_grid.items[map_grid_offset(xx, yy)];
+                if (building_id && building_get(building_id)->house_size) {
+                    service_area.houses[grid_offset][num_houses++] = building_id;
+                }
+            }
+        }
+        service_area.num_houses.items[grid_offset] = num_houses;
+        service_area.is_valid.items[grid_offset] = 1;
+    }
+    *houses = service_area.houses[grid_offset];
+    return service_area.num_houses.items[grid_offset];
 }
 
 void map_building_damage_clear(int grid_offset)
@@ -49,6 +95,7 @@ void map_building_clear(void)
     map_grid_clear_u16(buildings_grid.items);
     map_grid_clear_u8(damage_grid.items);
     map_grid_clear_u8(rubble_type_grid.items);
+    map_grid_clear_u8(service_area.is_valid.items);
 }
 
 void map_building_save_state(buffer *buildings, buffer *damage)
@@ -61,6 +108,7 @@ void map_building_load_state(buffer *buildings, buffer *damage)
 {
     map_grid_load_state_u16(buildings_grid.items, buildings);
     map_grid_load_state_u8(damage_grid.items, damage);
+    map_grid_clear_u8(service_area.is_valid.items);
 }
 
 int map_building_is_reservoir(int x, int y)
@@ -4,6 +4,8 @@
 #include "building/type.h"
 #include "core/buffer.h"
 
+#include <stdint.h>
+
 /**
  * Returns the building at the given offset
  * @param grid_offset Map offset
@@ -15,6 +17,16 @@ int map_building_from_buffer(buffer *buildings, int grid_offset);
 
 void map_building_set(int grid_offset, int building_id);
 
+/**
+ * Gets the houses a walker standing on the tile reaches, one entry per house tile in range.
+ * The list is cached per tile and invalidated whenever a building tile in range changes.
+ * @param x X tile of the walker
+ * @param y Y tile of the walker
+ * @param houses Receives the building IDs of the houses
+ * @return Number of entries in the list
+ */
+int map_building_houses_in_service_area(int x, int y, const uint16_t **houses);
+
 /**
  * Increases building damage by 1
  * @param grid_offset Map offset
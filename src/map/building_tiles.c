@@ -13,6 +13,7 @@
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/routing_terrain.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
@@ -41,11 +42,16 @@ void map_building_tiles_add_remove(int building_id, int x, int y, int size, int
         default:
             return;
     }
+    int land_changed = 0;
     for (int dy = 0; dy < size; dy++) {
         for (int dx = 0; dx < size; dx++) {
             int grid_offset = map_grid_offset(x + dx, y + dy);
+            int old_terrain = map_terrain_get(grid_offset);
             map_terrain_remove(grid_offset, terrain_to_remove);
             map_terrain_add(grid_offset, terrain_to_add);
+            if (old_terrain != map_terrain_get(grid_offset) || map_building_at(grid_offset) != building_id) {
+                land_changed = 1;
+            }
             map_building_set(grid_offset, building_id);
             map_property_clear_constructing(grid_offset);
             map_property_set_multi_tile_size(grid_offset, size);
@@ -54,6 +60,11 @@ void map_building_tiles_add_remove(int building_id, int x, int y, int size, int
                 dx == x_leftmost && dy == y_leftmost);
         }
     }
+    // Buildings like fountains re-add their tiles daily just to refresh the image
+    if (land_changed) {
+        map_routing_mark_land_dirty(x, y, size);
+        map_tiles_mark_for_update(x - 2, y - 2, x + size + 1, y + size + 1);
+    }
 }
 
 void map_building_tiles_add(int building_id, int x, int y, int size, int image_id, int terrain)
@@ -77,6 +88,8 @@ void map_building_tiles_add_farm(int building_id, int x, int y, int crop_image_i
     if (!map_grid_is_inside(x, y, 3)) {
         return;
     }
+    map_routing_mark_land_dirty(x, y, 3);
+    map_tiles_mark_for_update(x - 2, y - 2, x + 4, y + 4);
     // farmhouse
     int x_leftmost, y_leftmost;
     switch (city_view_orientation()) {
@@ -169,6 +182,8 @@ void map_building_tiles_remove(int building_id, int x, int y)
     if (building_id && building_is_farm(b->type)) {
         size = 3;
     }
+    map_routing_mark_land_dirty(x, y, size);
+    map_tiles_mark_for_update(x - 2, y - 2, x + size + 1, y + size + 1);
     for (int dy = 0; dy < size; dy++) {
         for (int dx = 0; dx < size; dx++) {
             int grid_offset = map_grid_offset(x + dx, y + dy);
@@ -207,6 +222,8 @@ void map_building_tiles_set_rubble(int building_id, int x, int y, int size)
     if (!map_grid_is_inside(x, y, size)) {
         return;
     }
+    map_routing_mark_land_dirty(x, y, size);
+    map_tiles_mark_for_update(x - 2, y - 2, x + size + 1, y + size + 1);
     building *b = building_get(building_id);
     for (int dy = 0; dy < size; dy++) {
         for (int dx = 0; dx < size; dx++) {
@@ -10,14 +10,22 @@
 #include "map/ring.h"
 #include "map/terrain.h"
 
+#include <string.h>
+
 static grid_i8 desirability_grid;
 
+// results of the update that is spread over several ticks, until it is published
+static struct {
+    grid_i8 grid;
+    int num_buildings;
+} pending;
+
 void map_desirability_clear(void)
 {
     map_grid_clear_i8(desirability_grid.items);
 }
 
-static void add_desirability_at_distance(int x, int y, int size, int distance, int desirability)
+static void add_desirability_at_distance(int8_t *grid, int x, int y, int size, int distance, int desirability)
 {
     int partially_outside_map = 0;
     if (x - distance < -1 || x + distance + size - 1 > map_data.width) {
@@ -34,20 +42,20 @@ static void add_desirability_at_distance(int x, int y, int size, int distance, i
         for (int i = start; i < end; i++) {
             const ring_tile *tile = map_ring_tile(i);
             if (map_ring_is_inside_map(x + tile->x, y + tile->y)) {
-                desirability_grid.items[base_offset + tile->grid_offset] =
-                    calc_bound(desirability_grid.items[base_offset + tile->grid_offset] + desirability, -100, 100);
+                grid[base_offset + tile->grid_offset] =
+                    calc_bound(grid[base_offset + tile->grid_offset] + desirability, -100, 100);
             }
         }
     } else {
         for (int i = start; i < end; i++) {
             const ring_tile *tile = map_ring_tile(i);
-            desirability_grid.items[base_offset + tile->grid_offset] =
-                calc_bound(desirability_grid.items[base_offset + tile->grid_offset] + desirability, -100, 100);
+            grid[base_offset + tile->grid_offset] =
+                calc_bound(grid[base_offset + tile->grid_offset] + desirability, -100, 100);
         }
     }
 }
 
-static void add_to_terrain(int x, int y, int size, int desirability, int step, int step_size, int range)
+static void add_to_terrain(int8_t *grid, int x, int y, int size, int desirability, int step, int step_size, int range)
 {
     if (size > 0) {
         if (range > 8) {
@@ -56,7 +64,7 @@ static void add_to_terrain(int x, int y, int size, int desirability, int step, i
         int tiles_within_step = 0;
         int distance = 1;
         while (range > 0) {
-            add_desirability_at_distance(x, y, size, distance, desirability);
+            add_desirability_at_distance(grid, x, y, size, distance, desirability);
             distance++;
             range--;
             tiles_within_step++;
@@ -68,7 +76,7 @@ static void add_to_terrain(int x, int y, int size, int desirability, int step, i
     }
 }
 
-static void update_buildings(void)
+static void update_buildings(int8_t *grid, int first_id, int last_id)
 {
     int value;
     int value_bonus;
@@ -77,7 +85,7 @@ static void update_buildings(void)
     int range;
     int venus_module2 = building_monument_gt_module_is_active(VENUS_MODULE_2_DESIRABILITY_ENTERTAINMENT);
     int venus_gt = building_monument_working(BUILDING_GRAND_TEMPLE_VENUS);
-    for (int i = 1; i < building_count(); i++) {
+    for (int i = first_id; i < last_id; i++) {
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE) {
 
@@ -120,7 +128,7 @@ static void update_buildings(void)
                 range += 1;
             }
 
-            add_to_terrain(
+            add_to_terrain(grid,
                 b->x, b->y, b->size,
                 value,
                 step,
@@ -130,7 +138,7 @@ static void update_buildings(void)
     }
 }
 
-static void add_garden_desirability(int x, int y)
+static void add_garden_desirability(int8_t *grid, int x, int y)
 {
     const model_building *model = model_get_building(BUILDING_GARDENS);
 
@@ -146,13 +154,13 @@ static void add_garden_desirability(int x, int y)
         range += 1;
     }
 
-    add_to_terrain(x, y, 1, value, step, step_size, range);
+    add_to_terrain(grid, x, y, 1, value, step, step_size, range);
 }
 
-static void update_terrain(void)
+static void update_terrain(int8_t *grid, int first_row, int last_row)
 {
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+    int grid_offset = map_data.start_offset + first_row * (map_data.width + map_data.border_size);
+    for (int y = first_row; y < last_row; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
             int terrain = map_terrain_get(grid_offset);
             if (map_property_is_plaza_earthquake_or_overgrown_garden(grid_offset)) {
@@ -163,7 +171,7 @@ static void update_terrain(void)
                     // earthquake fault line: slight negative
                     type = BUILDING_HOUSE_VACANT_LOT;
                 } else if (terrain & TERRAIN_GARDEN) {
-                    add_garden_desirability(x, y);
+                    add_garden_desirability(grid, x, y);
                     continue;
                 } else {
                     // invalid plaza/earthquake flag
@@ -171,18 +179,18 @@ static void update_terrain(void)
                     continue;
                 }
                 const model_building *model = model_get_building(type);
-                add_to_terrain(x, y, 1,
+                add_to_terrain(grid, x, y, 1,
                     model->desirability_value,
                     model->desirability_step,
                     model->desirability_step_size,
                     model->desirability_range);
             } else if (terrain & TERRAIN_GARDEN) {
-                add_garden_desirability(x, y);
+                add_garden_desirability(grid, x, y);
             } else if (terrain & TERRAIN_RUBBLE) {
-                add_to_terrain(x, y, 1, -2, 1, 1, 2);
+                add_to_terrain(grid, x, y, 1, -2, 1, 1, 2);
             } else if (terrain & TERRAIN_HIGHWAY) {
                 const model_building *model = model_get_building(BUILDING_HIGHWAY);
-                add_to_terrain(x, y, 1,
+                add_to_terrain(grid, x, y, 1,
                     model->desirability_value,
                     model->desirability_step,
                     model->desirability_step_size,
@@ -195,8 +203,33 @@ static void update_terrain(void)
 void map_desirability_update(void)
 {
     map_desirability_clear();
-    update_buildings();
-    update_terrain();
+    update_buildings(desirability_grid.items, 1, building_count());
+    update_terrain(desirability_grid.items, 0, map_data.height);
+}
+
+int map_desirability_start_update(void)
+{
+    map_grid_clear_i8(pending.grid.items);
+    // buildings created during the update are taken into account the next time
+    pending.num_buildings = building_count() - 1;
+    return pending.num_buildings + map_data.height;
+}
+
+void map_desirability_update_part(int first, int last)
+{
+    if (first < pending.num_buildings) {
+        int last_building = last < pending.num_buildings ? last : pending.num_buildings;
+        update_buildings(pending.grid.items, first + 1, last_building + 1);
+    }
+    if (last > pending.num_buildings) {
+        int first_row = first > pending.num_buildings ? first - pending.num_buildings : 0;
+        update_terrain(pending.grid.items, first_row, last - pending.num_buildings);
+    }
+}
+
+void map_desirability_finish_update(void)
+{
+    memcpy(desirability_grid.items, pending.grid.items, sizeof(desirability_grid.items));
 }
 
 int map_desirability_get(int grid_offset)
@@ -230,3 +263,21 @@ void map_desirability_load_state(buffer *buf)
 {
     map_grid_load_state_i8(desirability_grid.items, buf);
 }
+
+void map_desirability_clear_update(void)
+{
+    map_grid_clear_i8(pending.grid.items);
+    pending.num_buildings = 0;
+}
+
+void map_desirability_save_update_state(buffer *buf)
+{
+    buffer_write_i32(buf, pending.num_buildings);
+    map_grid_save_state_i8(pending.grid.items, buf);
+}
+
+void map_desirability_load_update_state(buffer *buf)
+{
+    pending.num_buildings = buffer_read_i32(buf);
+    map_grid_load_state_i8(pending.grid.items, buf);
+}
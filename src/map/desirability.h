@@ -7,6 +7,25 @@ void map_desirability_clear(void);
 
 void map_desirability_update(void);
 
+/**
+ * Starts an update of the desirability that is spread over several calls of map_desirability_update_part,
+ * the current desirability stays in use until map_desirability_finish_update
+ * @return Number of items to update: the buildings followed by the map rows
+ */
+int map_desirability_start_update(void);
+
+/**
+ * Adds the desirability of the given items to the pending update
+ * @param first First item to update
+ * @param last Item after the last item to update
+ */
+void map_desirability_update_part(int first, int last);
+
+/**
+ * Replaces the desirability with the result of the pending update
+ */
+void map_desirability_finish_update(void);
+
 int map_desirability_get(int grid_offset);
 
 int map_desirability_get_max(int x, int y, int size);
@@ -15,4 +34,10 @@ void map_desirability_save_state(buffer *buf);
 
 void map_desirability_load_state(buffer *buf);
 
+void map_desirability_clear_update(void);
+
+void map_desirability_save_update_state(buffer *buf);
+
+void map_desirability_load_update_state(buffer *buf);
+
 #endif // MAP_DESIRABILITY_H
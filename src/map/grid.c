@@ -258,6 +258,165 @@ void map_grid_copy_u32(const uint32_t *src, uint32_t *dst)
     memcpy(dst, src, GRID_SIZE * GRID_SIZE * sizeof(uint32_t));
 }
 
+void map_grid_backup_region_start(grid_backup_region *region)
+{
+    region->active = 1;
+    region->x_min = GRID_SIZE;
+    region->y_min = GRID_SIZE;
+    region->x_max = -1;
+    region->y_max = -1;
+}
+
+void map_grid_backup_region_stop(grid_backup_region *region)
+{
+    map_grid_backup_region_start(region);
+    region->active = 0;
+}
+
+static void copy_area(const uint8_t *src, uint8_t *dst, size_t element_size,
+    int x_min, int y_min, int x_max, int y_max)
+{
+    if (x_min > x_max) {
+        return;
+    }
+    size_t row_size = (x_max - x_min + 1) * element_size;
+    for (int y = y_min; y <= y_max; y++) {
+        size_t offset = OFFSET(x_min, y) * element_size;
+        memcpy(&dst[offset], &src[offset], row_size);
+    }
+}
+
+static void add_to_backup_region(grid_backup_region *region, int grid_offset,
+    const uint8_t *grid, uint8_t *backup, size_t element_size)
+{
+    if (!region->active || grid_offset < 0 || grid_offset >= GRID_SIZE * GRID_SIZE) {
+        return;
+    }
+    int x = grid_offset % GRID_SIZE;
+    int y = grid_offset / GRID_SIZE;
+    if (x >= region->x_min && x <= region->x_max && y >= region->y_min && y <= region->y_max) {
+        return;
+    }
+    if (region->x_min > region->x_max) {
+        copy_area(grid, backup, element_size, x, y, x, y);
+        region->x_min = region->x_max = x;
+        region->y_min = region->y_max = y;
+        return;
+    }
+    int x_min = x < region->x_min ? x : region->x_min;
+    int y_min = y < region->y_min ? y : region->y_min;
+    int x_max = x > region->x_max ? x : region->x_max;
+    int y_max = y > region->y_max ? y : region->y_max;
+    // everything outside the old region is still unchanged, so only the new strips need copying
+    copy_area(grid, backup, element_size, x_min, y_min, x_max, region->y_min - 1);
+    copy_area(grid, backup, element_size, x_min, region->y_max + 1, x_max, y_max);
+    copy_area(grid, backup, element_size, x_min, region->y_min, region->x_min - 1, region->y_max);
+    copy_area(grid, backup, element_size, region->x_max + 1, region->y_min, x_max, region->y_max);
+    region->x_min = x_min;
+    region->y_min = y_min;
+    region->x_max = x_max;
+    region->y_max = y_max;
+}
+
+void map_grid_backup_region_add_u8(grid_backup_region *region, int grid_offset, const uint8_t *grid, uint8_t *backup)
+{
+    add_to_backup_region(region, grid_offset, grid, backup, sizeof(uint8_t));
+}
+
+void map_grid_backup_region_add_u32(grid_backup_region *region, int grid_offset,
+    const uint32_t *grid, uint32_t *backup)
+{
+    add_to_backup_region(region, grid_offset, (const uint8_t *) grid, (uint8_t *) backup, sizeof(uint32_t));
+}
+
+void map_grid_backup_region_restore_u8(const grid_backup_region *region, const uint8_t *backup, uint8_t *grid)
+{
+    copy_area(backup, grid, sizeof(uint8_t), region->x_min, region->y_min, region->x_max, region->y_max);
+}
+
+void map_grid_backup_region_restore_u32(const grid_backup_region *region, const uint32_t *backup, uint32_t *grid)
+{
+    copy_area((const uint8_t *) backup, (uint8_t *) grid, sizeof(uint32_t),
+        region->x_min, region->y_min, region->x_max, region->y_max);
+}
+
+void map_grid_and_u8_with_backup(grid_backup_region *region, uint8_t *grid, uint8_t *backup, uint8_t mask)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (grid[i] & ~mask) {
+            map_grid_backup_region_add_u8(region, i, grid, backup);
+            grid[i] &= mask;
+        }
+    }
+}
+
+void map_grid_and_u32_with_backup(grid_backup_region *region, uint32_t *grid, uint32_t *backup, uint32_t mask)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (grid[i] & ~mask) {
+            map_grid_backup_region_add_u32(region, i, grid, backup);
+            grid[i] &= mask;
+        }
+    }
+}
+
+int map_grid_backup_region_area(const grid_backup_region *region, int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    if (region->x_min > region->x_max) {
+        return 0;
+    }
+    int start_x = map_data.start_offset % GRID_SIZE;
+    int start_y = map_data.start_offset / GRID_SIZE;
+    *x_min = region->x_min - start_x;
+    *y_min = region->y_min - start_y;
+    *x_max = region->x_max - start_x;
+    *y_max = region->y_max - start_y;
+    map_grid_bound_area(x_min, y_min, x_max, y_max);
+    return 1;
+}
+
+int map_grid_backup_region_saved_size(const grid_backup_region *region, int element_size)
+{
+    int size = 4 * sizeof(int16_t);
+    if (region->x_min <= region->x_max) {
+        size += (region->x_max - region->x_min + 1) * (region->y_max - region->y_min + 1) * element_size;
+    }
+    return size;
+}
+
+void map_grid_backup_region_save(const grid_backup_region *region, const void *backup, int element_size, buffer *buf)
+{
+    buffer_write_i16(buf, region->x_min);
+    buffer_write_i16(buf, region->y_min);
+    buffer_write_i16(buf, region->x_max);
+    buffer_write_i16(buf, region->y_max);
+    if (region->x_min > region->x_max) {
+        return;
+    }
+    const uint8_t *items = backup;
+    size_t row_size = (region->x_max - region->x_min + 1) * element_size;
+    for (int y = region->y_min; y <= region->y_max; y++) {
+        buffer_write_raw(buf, &items[OFFSET(region->x_min, y) * element_size], row_size);
+    }
+}
+
+void map_grid_backup_region_load(grid_backup_region *region, void *backup, int element_size, buffer *buf)
+{
+    region->active = 1;
+    region->x_min = buffer_read_i16(buf);
+    region->y_min = buffer_read_i16(buf);
+    region->x_max = buffer_read_i16(buf);
+    region->y_max = buffer_read_i16(buf);
+    if (region->x_min > region->x_max) {
+        return;
+    }
+    uint8_t *items = backup;
+    size_t row_size = (region->x_max - region->x_min + 1) * element_size;
+    for (int y = region->y_min; y <= region->y_max; y++) {
+        buffer_read_raw(buf, &items[OFFSET(region->x_min, y) * element_size], row_size);
+    }
+}
+
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf)
 {
     buffer_write_raw(buf, grid, GRID_SIZE * GRID_SIZE);
@@ -319,3 +478,53 @@ void map_grid_load_state_u32(uint32_t *grid, buffer *buf)
         grid[i] = buffer_read_u32(buf);
     }
 }
+
+static int saved_state_element_size(const buffer *buf)
+{
+    if (buf->size % (GRID_SIZE * GRID_SIZE)) {
+        return 0;
+    }
+    int element_size = (int) buf->size / (GRID_SIZE * GRID_SIZE);
+    return element_size == 1 || element_size == 2 || element_size == 4 ? element_size : 0;
+}
+
+void map_grid_filter_saved_state(buffer *buf)
+{
+    static uint8_t planes[GRID_SIZE * GRID_SIZE * sizeof(uint32_t)];
+    int element_size = saved_state_element_size(buf);
+    if (!element_size) {
+        return;
+    }
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        for (int plane = 0; plane < element_size; plane++) {
+            planes[plane * GRID_SIZE * GRID_SIZE + i] = buf->data[i * element_size + plane];
+        }
+    }
+    for (int i = (int) buf->size - 1; i >= 0; i--) {
+        // rows never cross planes, as every plane holds whole rows
+        if (i % (GRID_SIZE * GRID_SIZE) >= GRID_SIZE) {
+            planes[i] ^= planes[i - GRID_SIZE];
+        }
+    }
+    memcpy(buf->data, planes, buf->size);
+}
+
+void map_grid_unfilter_saved_state(buffer *buf)
+{
+    static uint8_t planes[GRID_SIZE * GRID_SIZE * sizeof(uint32_t)];
+    int element_size = saved_state_element_size(buf);
+    if (!element_size) {
+        return;
+    }
+    memcpy(planes, buf->data, buf->size);
+    for (int i = 0; i < (int) buf->size; i++) {
+        if (i % (GRID_SIZE * GRID_SIZE) >= GRID_SIZE) {
+            planes[i] ^= planes[i - GRID_SIZE];
+        }
+    }
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        for (int plane = 0; plane < element_size; plane++) {
+            buf->data[i * element_size + plane] = planes[plane * GRID_SIZE * GRID_SIZE + i];
+        }
+    }
+}
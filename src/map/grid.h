@@ -29,6 +29,18 @@ typedef struct {
     uint32_t items[GRID_SIZE * GRID_SIZE];
 } grid_u32;
 
+/**
+ * Rectangle of a grid that has been backed up. Tiles are copied to the backup the first time they change,
+ * so only the part of the grid that actually changed has to be backed up and restored.
+ */
+typedef struct {
+    int active;
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} grid_backup_region;
+
 void map_grid_init(int width, int height, int start_offset, int border_size);
 
 int map_grid_is_valid_offset(int grid_offset);
@@ -93,6 +105,75 @@ void map_grid_copy_u16(const uint16_t *src, uint16_t *dst);
 
 void map_grid_copy_u32(const uint32_t *src, uint32_t *dst);
 
+/**
+ * Starts backing up a grid: the region is emptied and from now on grows with every changed tile
+ * @param region Region to start
+ */
+void map_grid_backup_region_start(grid_backup_region *region);
+
+/**
+ * Stops backing up a grid, for example because it was replaced as a whole
+ * @param region Region to stop
+ */
+void map_grid_backup_region_stop(grid_backup_region *region);
+
+/**
+ * Makes sure the given tile is backed up before it is changed, growing the region if needed
+ * @param region Backup region of the grid
+ * @param grid_offset Tile that is about to change
+ * @param grid Grid that is about to change
+ * @param backup Backup of the grid
+ */
+void map_grid_backup_region_add_u8(grid_backup_region *region, int grid_offset, const uint8_t *grid, uint8_t *backup);
+
+void map_grid_backup_region_add_u32(grid_backup_region *region, int grid_offset,
+    const uint32_t *grid, uint32_t *backup);
+
+/**
+ * Copies the backed up region back to the grid
+ * @param region Backup region of the grid
+ * @param backup Backup of the grid
+ * @param grid Grid to restore
+ */
+void map_grid_backup_region_restore_u8(const grid_backup_region *region, const uint8_t *backup, uint8_t *grid);
+
+void map_grid_backup_region_restore_u32(const grid_backup_region *region, const uint32_t *backup, uint32_t *grid);
+
+/**
+ * Same as map_grid_and_u8, but backs up every tile that changes
+ */
+void map_grid_and_u8_with_backup(grid_backup_region *region, uint8_t *grid, uint8_t *backup, uint8_t mask);
+
+void map_grid_and_u32_with_backup(grid_backup_region *region, uint32_t *grid, uint32_t *backup, uint32_t mask);
+
+/**
+ * Returns the backed up rectangle in map coordinates
+ * @return 1 if the region contains tiles, 0 if nothing was backed up
+ */
+int map_grid_backup_region_area(const grid_backup_region *region, int *x_min, int *y_min, int *x_max, int *y_max);
+
+/**
+ * Returns the number of bytes map_grid_backup_region_save writes
+ */
+int map_grid_backup_region_saved_size(const grid_backup_region *region, int element_size);
+
+/**
+ * Writes the backed up rectangle and its values from the backup grid to the buffer
+ * @param region Backup region of the grid
+ * @param backup Backup of the grid
+ * @param element_size Size of one grid item
+ * @param buf Buffer to write to
+ */
+void map_grid_backup_region_save(const grid_backup_region *region, const void *backup, int element_size, buffer *buf);
+
+/**
+ * Reads a region written by map_grid_backup_region_save back into the backup grid, so it can be restored
+ * @param region Backup region of the grid, set to the saved rectangle
+ * @param backup Backup of the grid
+ * @param element_size Size of one grid item
+ * @param buf Buffer to read from
+ */
+void map_grid_backup_region_load(grid_backup_region *region, void *backup, int element_size, buffer *buf);
 
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf);
 
@@ -114,4 +195,17 @@ void map_grid_load_state_u16_to_u32(uint32_t *grid, buffer *buf);
 
 void map_grid_load_state_u32(uint32_t *grid, buffer *buf);
 
+/**
+ * Filters a saved grid in place so it compresses better: multi-byte values are split into byte planes
+ * and every row is XOR-ed with the row above it
+ * @param buf Buffer holding a grid of 1, 2 or 4 byte values
+ */
+void map_grid_filter_saved_state(buffer *buf);
+
+/**
+ * Reverts map_grid_filter_saved_state
+ * @param buf Buffer holding a filtered grid
+ */
+void map_grid_unfilter_saved_state(buffer *buf);
+
 #endif // MAP_GRID_H
@@ -5,6 +5,7 @@
 #include "core/calc.h"
 #include "core/image.h"
 #include "core/image_group.h"
+#include "map/building.h"
 #include "map/building_tiles.h"
 #include "map/grid.h"
 #include "map/orientation.h"
@@ -12,6 +13,7 @@
 
 static grid_u32 images;
 static grid_u32 images_backup;
+static grid_backup_region backup_region;
 
 unsigned int map_image_at(int grid_offset)
 {
@@ -20,26 +22,54 @@ unsigned int map_image_at(int grid_offset)
 
 void map_image_set(int grid_offset, int image_id)
 {
+    map_grid_backup_region_add_u32(&backup_region, grid_offset, images.items, images_backup.items);
     images.items[grid_offset] = image_id;
 }
 
 void map_image_backup(void)
 {
-    map_grid_copy_u32(images.items, images_backup.items);
+    map_grid_backup_region_start(&backup_region);
 }
 
 void map_image_restore(void)
 {
-    map_grid_copy_u32(images_backup.items, images.items);
+    map_grid_backup_region_restore_u32(&backup_region, images_backup.items, images.items);
 }
 
-void map_image_restore_at(int grid_offset)
+int map_image_backup_size(void)
 {
-    images.items[grid_offset] = images_backup.items[grid_offset];
+    return map_grid_backup_region_saved_size(&backup_region, sizeof(images_backup.items[0]));
+}
+
+void map_image_save_backup(buffer *buf)
+{
+    map_grid_backup_region_save(&backup_region, images_backup.items, sizeof(images_backup.items[0]), buf);
+}
+
+void map_image_load_backup(buffer *buf)
+{
+    map_grid_backup_region_load(&backup_region, images_backup.items, sizeof(images_backup.items[0]), buf);
+}
+
+void map_image_restore_except_buildings(void)
+{
+    int x_min, y_min, x_max, y_max;
+    if (!map_grid_backup_region_area(&backup_region, &x_min, &y_min, &x_max, &y_max)) {
+        return;
+    }
+    for (int y = y_min; y <= y_max; y++) {
+        for (int x = x_min; x <= x_max; x++) {
+            int grid_offset = map_grid_offset(x, y);
+            if (!map_building_at(grid_offset)) {
+                images.items[grid_offset] = images_backup.items[grid_offset];
+            }
+        }
+    }
 }
 
 void map_image_clear(void)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_clear_u32(images.items);
 }
 
@@ -88,5 +118,6 @@ void map_image_save_state_legacy(buffer *buf)
 
 void map_image_load_state_legacy(buffer *buf)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_load_state_u16_to_u32(images.items, buf);
 }
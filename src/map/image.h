@@ -11,7 +11,16 @@ void map_image_backup(void);
 
 void map_image_restore(void);
 
-void map_image_restore_at(int grid_offset);
+int map_image_backup_size(void);
+
+void map_image_save_backup(buffer *buf);
+
+void map_image_load_backup(buffer *buf);
+
+/**
+ * Restores the backed up images of the changed tiles that do not hold a building
+ */
+void map_image_restore_except_buildings(void);
 
 void map_image_clear(void);
 void map_image_init_edges(void);
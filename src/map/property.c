@@ -35,11 +35,24 @@ static grid_u8 bitfields_grid;
 static grid_u8 edge_backup;
 static grid_u8 bitfields_backup;
 
+static grid_backup_region edge_backup_region;
+static grid_backup_region bitfields_backup_region;
+
 static int edge_for(int x, int y)
 {
     return 8 * y + x;
 }
 
+static void backup_edge(int grid_offset)
+{
+    map_grid_backup_region_add_u8(&edge_backup_region, grid_offset, edge_grid.items, edge_backup.items);
+}
+
+static void backup_bitfields(int grid_offset)
+{
+    map_grid_backup_region_add_u8(&bitfields_backup_region, grid_offset, bitfields_grid.items, bitfields_backup.items);
+}
+
 int map_property_is_draw_tile(int grid_offset)
 {
     return edge_grid.items[grid_offset] & EDGE_LEFTMOST_TILE;
@@ -53,11 +66,13 @@ int map_property_is_draw_tile_from_buffer(buffer *edge, int grid_offset)
 
 void map_property_mark_draw_tile(int grid_offset)
 {
+    backup_edge(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_LEFTMOST_TILE;
 }
 
 void map_property_clear_draw_tile(int grid_offset)
 {
+    backup_edge(grid_offset);
     edge_grid.items[grid_offset] &= ~EDGE_LEFTMOST_TILE;
 }
 
@@ -68,12 +83,13 @@ int map_property_is_native_land(int grid_offset)
 
 void map_property_mark_native_land(int grid_offset)
 {
+    backup_edge(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_NATIVE_LAND;
 }
 
 void map_property_clear_all_native_land(void)
 {
-    map_grid_and_u8(edge_grid.items, EDGE_NO_NATIVE_LAND);
+    map_grid_and_u8_with_backup(&edge_backup_region, edge_grid.items, edge_backup.items, EDGE_NO_NATIVE_LAND);
 }
 
 int map_property_multi_tile_xy(int grid_offset)
@@ -98,6 +114,7 @@ int map_property_is_multi_tile_xy(int grid_offset, int x, int y)
 
 void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_tile)
 {
+    backup_edge(grid_offset);
     if (is_draw_tile) {
         edge_grid.items[grid_offset] = edge_for(x, y) | EDGE_LEFTMOST_TILE;
     } else {
@@ -107,6 +124,7 @@ void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_t
 
 void map_property_clear_multi_tile_xy(int grid_offset)
 {
+    backup_edge(grid_offset);
     // only keep native land marker
     edge_grid.items[grid_offset] &= EDGE_NATIVE_LAND;
 }
@@ -138,6 +156,7 @@ int map_property_multi_tile_size_from_buffer(buffer *bitfields, int grid_offset)
 
 void map_property_set_multi_tile_size(int grid_offset, int size)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_SIZES;
     switch (size) {
         case 2: bitfields_grid.items[grid_offset] |= BIT_SIZE2; break;
@@ -175,11 +194,13 @@ int map_property_is_plaza_earthquake_or_overgrown_garden(int grid_offset)
 
 void map_property_mark_plaza_earthquake_or_overgrown_garden(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_PLAZA_EARTHQUAKE_OR_OVERGROWN_GARDEN;
 }
 
 void map_property_clear_plaza_earthquake_or_overgrown_garden(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_PLAZA;
 }
 
@@ -190,11 +211,13 @@ int map_property_is_constructing(int grid_offset)
 
 void map_property_mark_constructing(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_CONSTRUCTION;
 }
 
 void map_property_clear_constructing(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_CONSTRUCTION;
 }
 
@@ -205,35 +228,58 @@ int map_property_is_deleted(int grid_offset)
 
 void map_property_mark_deleted(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_DELETED;
 }
 
 void map_property_clear_deleted(int grid_offset)
 {
+    backup_bitfields(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_DELETED;
 }
 
 void map_property_clear_constructing_and_deleted(void)
 {
-    map_grid_and_u8(bitfields_grid.items, BIT_NO_CONSTRUCTION_AND_DELETED);
+    map_grid_and_u8_with_backup(&bitfields_backup_region, bitfields_grid.items, bitfields_backup.items,
+        BIT_NO_CONSTRUCTION_AND_DELETED);
 }
 
 void map_property_clear(void)
 {
+    map_grid_backup_region_stop(&bitfields_backup_region);
+    map_grid_backup_region_stop(&edge_backup_region);
     map_grid_clear_u8(bitfields_grid.items);
     map_grid_clear_u8(edge_grid.items);
 }
 
 void map_property_backup(void)
 {
-    map_grid_copy_u8(bitfields_grid.items, bitfields_backup.items);
-    map_grid_copy_u8(edge_grid.items, edge_backup.items);
+    map_grid_backup_region_start(&bitfields_backup_region);
+    map_grid_backup_region_start(&edge_backup_region);
 }
 
 void map_property_restore(void)
 {
-    map_grid_copy_u8(bitfields_backup.items, bitfields_grid.items);
-    map_grid_copy_u8(edge_backup.items, edge_grid.items);
+    map_grid_backup_region_restore_u8(&bitfields_backup_region, bitfields_backup.items, bitfields_grid.items);
+    map_grid_backup_region_restore_u8(&edge_backup_region, edge_backup.items, edge_grid.items);
+}
+
+int map_property_backup_size(void)
+{
+    return map_grid_backup_region_saved_size(&bitfields_backup_region, sizeof(bitfields_backup.items[0])) +
+        map_grid_backup_region_saved_size(&edge_backup_region, sizeof(edge_backup.items[0]));
+}
+
+void map_property_save_backup(buffer *buf)
+{
+    map_grid_backup_region_save(&bitfields_backup_region, bitfields_backup.items, sizeof(bitfields_backup.items[0]), buf);
+    map_grid_backup_region_save(&edge_backup_region, edge_backup.items, sizeof(edge_backup.items[0]), buf);
+}
+
+void map_property_load_backup(buffer *buf)
+{
+    map_grid_backup_region_load(&bitfields_backup_region, bitfields_backup.items, sizeof(bitfields_backup.items[0]), buf);
+    map_grid_backup_region_load(&edge_backup_region, edge_backup.items, sizeof(edge_backup.items[0]), buf);
 }
 
 void map_property_save_state(buffer *bitfields, buffer *edge)
@@ -244,6 +290,8 @@ void map_property_save_state(buffer *bitfields, buffer *edge)
 
 void map_property_load_state(buffer *bitfields, buffer *edge)
 {
+    map_grid_backup_region_stop(&bitfields_backup_region);
+    map_grid_backup_region_stop(&edge_backup_region);
     map_grid_load_state_u8(bitfields_grid.items, bitfields);
     map_grid_load_state_u8(edge_grid.items, edge);
 }
@@ -58,6 +58,12 @@ void map_property_clear(void);
 void map_property_backup(void);
 void map_property_restore(void);
 
+int map_property_backup_size(void);
+
+void map_property_save_backup(buffer *buf);
+
+void map_property_load_backup(buffer *buf);
+
 void map_property_save_state(buffer *bitfields, buffer *edge);
 void map_property_load_state(buffer *bitfields, buffer *edge);
 
@@ -1,6 +1,7 @@
 #include "routing.h"
 
 #include "building/building.h"
+#include "core/performance.h"
 #include "core/time.h"
 #include "map/building.h"
 #include "map/figure.h"
@@ -50,6 +51,19 @@ static struct {
     int items[MAX_QUEUE];
 } queue;
 
+// The distances from the start of a routed construction are kept until anything else uses the grid,
+// so dragging a road or aqueduct does not flood the whole map again on every mouse move.
+// They are only calculated as far as needed to reach the end of the construction and the
+// queue is kept, so that a longer drag continues where the previous one stopped.
+static struct {
+    int valid;
+    routed_building_type type;
+    int source_offset;
+    int result;
+    int tiles;
+    int (*callback)(int next_offset, int dist, int direction);
+} building_distances;
+
 static grid_u8 water_drag;
 
 static struct {
@@ -78,6 +92,7 @@ const map_routing_distance_grid *map_routing_get_distance_grid(void)
 
 static void clear_data(void)
 {
+    building_distances.valid = 0;
     reset_fighting_status();
     map_grid_clear_i16(distance.possible.items);
     map_grid_clear_i16(distance.determined.items);
@@ -202,6 +217,7 @@ static int receive_highway_bonus(int offset, int direction)
 static void route_queue_from_to(int src_x, int src_y, int dst_x, int dst_y, int num_directions, int max_tiles,
     int (*callback)(int offset, int next_offset, int direction))
 {
+    performance_add(PERFORMANCE_COUNTER_ROUTES, 1);
     clear_data();
     distance.dst_x = dst_x;
     distance.dst_y = dst_y;
@@ -233,6 +249,7 @@ static void route_queue_from_to(int src_x, int src_y, int dst_x, int dst_y, int
 static void route_queue_all_from(int source, max_directions directions,
     int (*callback)(int next_offset, int dist, int direction), int is_boat)
 {
+    performance_add(PERFORMANCE_COUNTER_ROUTES, 1);
     clear_data();
     map_grid_clear_u8(water_drag.items);
     enqueue(source, 1);
@@ -447,21 +464,23 @@ static int map_can_place_initial_road_or_aqueduct(int grid_offset, int is_aquedu
     }
 }
 
-int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+static int start_distances_for_building(routed_building_type type, int source_offset)
 {
-    int source_offset = map_grid_offset(x, y);
+    performance_add(PERFORMANCE_COUNTER_ROUTES, 1);
+    clear_data();
+
     if (type == ROUTED_BUILDING_WALL) {
-        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_wall, 0);
+        building_distances.callback = callback_calc_distance_build_wall;
+        enqueue(source_offset, 1);
         return 1;
     }
 
-    clear_data();
-
     if (type == ROUTED_BUILDING_HIGHWAY) {
         if (!can_build_highway(source_offset, 0)) {
             return 0;
         }
-        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_highway, 0);
+        building_distances.callback = callback_calc_distance_build_highway;
+        enqueue(source_offset, 1);
         return 1;
     }
 
@@ -474,13 +493,69 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
     }
     ++stats.total_routes_calculated;
     if (type == ROUTED_BUILDING_ROAD) {
-        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_road, 0);
+        building_distances.callback = callback_calc_distance_build_road;
     } else {
-        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_aqueduct, 0);
+        building_distances.callback = callback_calc_distance_build_aqueduct;
     }
+    enqueue(source_offset, 1);
     return 1;
 }
 
+static void expand_distances_for_building(int dest_offset)
+{
+    // The queue is first in, first out: once the destination has a distance, every tile closer to the start
+    // has its final distance, which is all that walking back from the destination looks at
+    while (queue.head != queue.tail) {
+        if (dest_offset >= 0 && distance.determined.items[dest_offset]) {
+            return;
+        }
+        if (++building_distances.tiles > GUARD) {
+            return;
+        }
+        int offset = queue_pop();
+        int dist = 1 + distance.determined.items[offset];
+        for (int i = 0; i < DIRECTIONS_NO_DIAGONALS; i++) {
+            int next_offset = offset + ROUTE_OFFSETS[i];
+            if (valid_offset(next_offset, dist)) {
+                building_distances.callback(next_offset, dist, i);
+            }
+        }
+    }
+}
+
+static int calculate_distances_for_building(routed_building_type type, int source_offset, int dest_offset)
+{
+    if (!building_distances.valid || building_distances.type != type ||
+        building_distances.source_offset != source_offset) {
+        int result = start_distances_for_building(type, source_offset);
+        building_distances.valid = 1;
+        building_distances.type = type;
+        building_distances.source_offset = source_offset;
+        building_distances.result = result;
+        building_distances.tiles = 0;
+    }
+    if (building_distances.result) {
+        expand_distances_for_building(dest_offset);
+    }
+    return building_distances.result;
+}
+
+int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+{
+    return calculate_distances_for_building(type, map_grid_offset(x, y), -1);
+}
+
+int map_routing_calculate_distances_for_building_to(routed_building_type type,
+    int x_start, int y_start, int x_end, int y_end)
+{
+    return calculate_distances_for_building(type, map_grid_offset(x_start, y_start), map_grid_offset(x_end, y_end));
+}
+
+void map_routing_invalidate_building_distances(void)
+{
+    building_distances.valid = 0;
+}
+
 static int callback_delete_wall_aqueduct(int next_offset, int dist, int direction)
 {
     if (terrain_land_citizen.items[next_offset] < CITIZEN_0_ROAD) {
@@ -664,6 +739,7 @@ void map_routing_block(int x, int y, int size)
     if (!map_grid_is_inside(x, y, size)) {
         return;
     }
+    building_distances.valid = 0;
     for (int dy = 0; dy < size; dy++) {
         for (int dx = 0; dx < size; dx++) {
             distance.determined.items[map_grid_offset(x + dx, y + dy)] = 0;
@@ -25,8 +25,25 @@ void map_routing_calculate_distances(int x, int y);
 void map_routing_calculate_distances_water_boat(int x, int y);
 void map_routing_calculate_distances_water_flotsam(int x, int y);
 
+/**
+ * Calculates the distances from the start of a routed construction to every reachable tile. The result
+ * is kept and reused when called again for the same type and start, until the distance grid is used
+ * for anything else or the land types change
+ */
 int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y);
 
+/**
+ * Same as map_routing_calculate_distances_for_building, but stops as soon as the end tile is reached.
+ * The distances of all tiles closer to the start than the end are the same as with the full calculation.
+ */
+int map_routing_calculate_distances_for_building_to(routed_building_type type,
+    int x_start, int y_start, int x_end, int y_end);
+
+/**
+ * Forces the next routed construction to calculate its distances again, for when the terrain changed
+ */
+void map_routing_invalidate_building_distances(void);
+
 void map_routing_delete_first_wall_or_aqueduct(int x, int y);
 
 int map_routing_distance(int grid_offset);
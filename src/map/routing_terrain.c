@@ -9,11 +9,22 @@
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/routing.h"
 #include "map/routing_data.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
 
+static struct {
+    int active;
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} dirty_land;
+
 static void map_routing_update_land_noncitizen(void);
+static void update_land_citizen_tile(int grid_offset);
+static void update_land_noncitizen_tile(int grid_offset);
 
 void map_routing_update_all(void)
 {
@@ -24,10 +35,62 @@ void map_routing_update_all(void)
 
 void map_routing_update_land(void)
 {
+    dirty_land.active = 0;
     map_routing_update_land_citizen();
     map_routing_update_land_noncitizen();
 }
 
+void map_routing_update_land_area(int x_min, int y_min, int x_max, int y_max)
+{
+    map_routing_invalidate_building_distances();
+    map_grid_bound_area(&x_min, &y_min, &x_max, &y_max);
+    for (int y = y_min; y <= y_max; y++) {
+        int grid_offset = map_grid_offset(x_min, y);
+        for (int x = x_min; x <= x_max; x++, grid_offset++) {
+            update_land_citizen_tile(grid_offset);
+            update_land_noncitizen_tile(grid_offset);
+        }
+    }
+}
+
+void map_routing_mark_land_dirty(int x, int y, int size)
+{
+    // Include a one tile border: aqueduct land types depend on the image, which changes with the neighbours
+    int x_min = x - 1;
+    int y_min = y - 1;
+    int x_max = x + size;
+    int y_max = y + size;
+    if (!dirty_land.active) {
+        dirty_land.active = 1;
+        dirty_land.x_min = x_min;
+        dirty_land.y_min = y_min;
+        dirty_land.x_max = x_max;
+        dirty_land.y_max = y_max;
+        return;
+    }
+    if (x_min < dirty_land.x_min) {
+        dirty_land.x_min = x_min;
+    }
+    if (y_min < dirty_land.y_min) {
+        dirty_land.y_min = y_min;
+    }
+    if (x_max > dirty_land.x_max) {
+        dirty_land.x_max = x_max;
+    }
+    if (y_max > dirty_land.y_max) {
+        dirty_land.y_max = y_max;
+    }
+}
+
+void map_routing_update_land_dirty(void)
+{
+    if (!dirty_land.active) {
+        return;
+    }
+    dirty_land.active = 0;
+    map_routing_update_land_area(dirty_land.x_min, dirty_land.y_min, dirty_land.x_max, dirty_land.y_max);
+}
+
 static int get_land_type_citizen_building(int grid_offset)
 {
     building *b = building_get(map_building_at(grid_offset));
@@ -99,37 +162,43 @@ static int get_land_type_citizen_aqueduct(int grid_offset)
     }
 }
 
+static void update_land_citizen_tile(int grid_offset)
+{
+    int terrain = map_terrain_get(grid_offset);
+    if (terrain & TERRAIN_ROAD) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_0_ROAD;
+    } else if (terrain & TERRAIN_HIGHWAY) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_1_HIGHWAY;
+    } else if (terrain & (TERRAIN_RUBBLE | TERRAIN_ACCESS_RAMP | TERRAIN_GARDEN)) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_2_PASSABLE_TERRAIN;
+    } else if (terrain & (TERRAIN_BUILDING | TERRAIN_GATEHOUSE)) {
+        if (!map_building_at(grid_offset)) {
+            // shouldn't happen
+            terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
+            map_terrain_remove(grid_offset, TERRAIN_BUILDING);
+            map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
+            map_property_mark_draw_tile(grid_offset);
+            map_property_set_multi_tile_size(grid_offset, 1);
+            return;
+        }
+        terrain_land_citizen.items[grid_offset] = get_land_type_citizen_building(grid_offset);
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        terrain_land_citizen.items[grid_offset] = get_land_type_citizen_aqueduct(grid_offset);
+    } else if (terrain & TERRAIN_NOT_CLEAR) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_N1_BLOCKED;
+    } else {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN;
+    }
+}
+
 void map_routing_update_land_citizen(void)
 {
+    map_routing_invalidate_building_distances();
     map_grid_init_i8(terrain_land_citizen.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            int terrain = map_terrain_get(grid_offset);
-            if (terrain & TERRAIN_ROAD) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_0_ROAD;
-            } else if (terrain & TERRAIN_HIGHWAY) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_1_HIGHWAY;
-            } else if (terrain & (TERRAIN_RUBBLE | TERRAIN_ACCESS_RAMP | TERRAIN_GARDEN)) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_2_PASSABLE_TERRAIN;
-            } else if (terrain & (TERRAIN_BUILDING | TERRAIN_GATEHOUSE)) {
-                if (!map_building_at(grid_offset)) {
-                    // shouldn't happen
-                    terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
-                    map_terrain_remove(grid_offset, TERRAIN_BUILDING);
-                    map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
-                    map_property_mark_draw_tile(grid_offset);
-                    map_property_set_multi_tile_size(grid_offset, 1);
-                    continue;
-                }
-                terrain_land_citizen.items[grid_offset] = get_land_type_citizen_building(grid_offset);
-            } else if (terrain & TERRAIN_AQUEDUCT) {
-                terrain_land_citizen.items[grid_offset] = get_land_type_citizen_aqueduct(grid_offset);
-            } else if (terrain & TERRAIN_NOT_CLEAR) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_N1_BLOCKED;
-            } else {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN;
-            }
+            update_land_citizen_tile(grid_offset);
         }
     }
 }
@@ -176,32 +245,37 @@ static int get_land_type_noncitizen(int grid_offset)
     return type;
 }
 
+static void update_land_noncitizen_tile(int grid_offset)
+{
+    int terrain = map_terrain_get(grid_offset);
+    if (terrain & TERRAIN_GATEHOUSE) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_4_GATEHOUSE;
+    } else if (terrain & TERRAIN_BUILDING) {
+        terrain_land_noncitizen.items[grid_offset] = get_land_type_noncitizen(grid_offset);
+    } else if (terrain & TERRAIN_ROAD) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
+    } else if (terrain & TERRAIN_HIGHWAY) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
+    } else if (terrain & (TERRAIN_GARDEN | TERRAIN_ACCESS_RAMP | TERRAIN_RUBBLE)) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
+    } else if (terrain & TERRAIN_WALL) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_3_WALL;
+    } else if (terrain & TERRAIN_NOT_CLEAR) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_N1_BLOCKED;
+    } else {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
+    }
+}
+
 static void map_routing_update_land_noncitizen(void)
 {
     map_grid_init_i8(terrain_land_noncitizen.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            int terrain = map_terrain_get(grid_offset);
-            if (terrain & TERRAIN_GATEHOUSE) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_4_GATEHOUSE;
-            } else if (terrain & TERRAIN_BUILDING) {
-                terrain_land_noncitizen.items[grid_offset] = get_land_type_noncitizen(grid_offset);
-            } else if (terrain & TERRAIN_ROAD) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
-            } else if (terrain & TERRAIN_HIGHWAY) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
-            } else if (terrain & (TERRAIN_GARDEN | TERRAIN_ACCESS_RAMP | TERRAIN_RUBBLE)) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
-            } else if (terrain & TERRAIN_AQUEDUCT) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
-            } else if (terrain & TERRAIN_WALL) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_3_WALL;
-            } else if (terrain & TERRAIN_NOT_CLEAR) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_N1_BLOCKED;
-            } else {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
-            }
+            update_land_noncitizen_tile(grid_offset);
         }
     }
 }
@@ -280,6 +354,7 @@ static int count_adjacent_wall_tiles(int grid_offset)
 
 void map_routing_update_walls(void)
 {
+    map_routing_invalidate_building_distances();
     map_grid_init_i8(terrain_walls.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
@@ -4,6 +4,24 @@
 void map_routing_update_all(void);
 void map_routing_update_land(void);
 void map_routing_update_land_citizen(void);
+
+/**
+ * Recalculates the citizen and non-citizen land types for the given (inclusive) area only
+ */
+void map_routing_update_land_area(int x_min, int y_min, int x_max, int y_max);
+
+/**
+ * Marks the area of a building footprint as needing a land type update
+ * @param x X of the north tile
+ * @param y Y of the north tile
+ * @param size Size of the footprint
+ */
+void map_routing_mark_land_dirty(int x, int y, int size);
+
+/**
+ * Recalculates the land types of the tiles marked dirty since the last update
+ */
+void map_routing_update_land_dirty(void);
 void map_routing_update_water(void);
 void map_routing_update_walls(void);
 
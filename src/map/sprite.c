@@ -4,6 +4,7 @@
 
 static grid_u8 sprite;
 static grid_u8 sprite_backup;
+static grid_backup_region backup_region;
 
 int map_sprite_animation_at(int grid_offset)
 {
@@ -12,6 +13,7 @@ int map_sprite_animation_at(int grid_offset)
 
 void map_sprite_animation_set(int grid_offset, int value)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, sprite.items, sprite_backup.items);
     sprite.items[grid_offset] = value;
 }
 
@@ -22,37 +24,58 @@ int map_sprite_bridge_at(int grid_offset)
 
 void map_sprite_bridge_set(int grid_offset, int value)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, sprite.items, sprite_backup.items);
     sprite.items[grid_offset] = value;
 }
 
 void map_sprite_clear_tile(int grid_offset)
 {
+    map_grid_backup_region_add_u8(&backup_region, grid_offset, sprite.items, sprite_backup.items);
     sprite.items[grid_offset] = 0;
 }
 
 void map_sprite_clear(void)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_clear_u8(sprite.items);
 }
 
 void map_sprite_backup(void)
 {
-    map_grid_copy_u8(sprite.items, sprite_backup.items);
+    map_grid_backup_region_start(&backup_region);
 }
 
 void map_sprite_restore(void)
 {
-    map_grid_copy_u8(sprite_backup.items, sprite.items);
+    map_grid_backup_region_restore_u8(&backup_region, sprite_backup.items, sprite.items);
+}
+
+int map_sprite_backup_size(void)
+{
+    return map_grid_backup_region_saved_size(&backup_region, sizeof(sprite_backup.items[0]));
+}
+
+void map_sprite_save_backup(buffer *buf)
+{
+    map_grid_backup_region_save(&backup_region, sprite_backup.items, sizeof(sprite_backup.items[0]), buf);
+}
+
+void map_sprite_load_backup(buffer *buf)
+{
+    map_grid_backup_region_load(&backup_region, sprite_backup.items, sizeof(sprite_backup.items[0]), buf);
 }
 
 void map_sprite_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(sprite.items, buf);
-    map_grid_save_state_u8(sprite_backup.items, backup);
+    // the backup is only valid inside the region of the last construction, so the grid itself is stored
+    // to keep equal states saving equally
+    map_grid_save_state_u8(sprite.items, backup);
 }
 
 void map_sprite_load_state(buffer *buf, buffer *backup)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_load_state_u8(sprite.items, buf);
     map_grid_load_state_u8(sprite_backup.items, backup);
 }
@@ -27,6 +27,12 @@ void map_sprite_backup(void);
 
 void map_sprite_restore(void);
 
+int map_sprite_backup_size(void);
+
+void map_sprite_save_backup(buffer *buf);
+
+void map_sprite_load_backup(buffer *buf);
+
 void map_sprite_save_state(buffer *buf, buffer *backup);
 
 void map_sprite_load_state(buffer *buf, buffer *backup);
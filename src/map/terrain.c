@@ -5,9 +5,11 @@
 #include "map/grid.h"
 #include "map/ring.h"
 #include "map/routing.h"
+#include "map/water_supply.h"
 
 static grid_u32 terrain_grid;
 static grid_u32 terrain_grid_backup;
+static grid_backup_region backup_region;
 
 int map_terrain_is(int grid_offset, int terrain)
 {
@@ -38,16 +40,28 @@ int map_terrain_get_from_buffer_32(buffer *buf, int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
+    if ((terrain_grid.items[grid_offset] ^ terrain) & TERRAIN_AQUEDUCT) {
+        map_water_supply_aqueduct_changed(grid_offset);
+    }
+    map_grid_backup_region_add_u32(&backup_region, grid_offset, terrain_grid.items, terrain_grid_backup.items);
     terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
+    if (terrain & TERRAIN_AQUEDUCT && !(terrain_grid.items[grid_offset] & TERRAIN_AQUEDUCT)) {
+        map_water_supply_aqueduct_changed(grid_offset);
+    }
+    map_grid_backup_region_add_u32(&backup_region, grid_offset, terrain_grid.items, terrain_grid_backup.items);
     terrain_grid.items[grid_offset] |= terrain;
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
+    if (terrain & terrain_grid.items[grid_offset] & TERRAIN_AQUEDUCT) {
+        map_water_supply_aqueduct_changed(grid_offset);
+    }
+    map_grid_backup_region_add_u32(&backup_region, grid_offset, terrain_grid.items, terrain_grid_backup.items);
     terrain_grid.items[grid_offset] &= ~terrain;
 }
 
@@ -77,7 +91,10 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain)
 {
-    map_grid_and_u32(terrain_grid.items, ~terrain);
+    if (terrain & TERRAIN_AQUEDUCT) {
+        map_water_supply_clear();
+    }
+    map_grid_and_u32_with_backup(&backup_region, terrain_grid.items, terrain_grid_backup.items, ~terrain);
 }
 
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
@@ -393,17 +410,35 @@ void map_terrain_add_triumphal_arch_roads(int x, int y, int orientation)
 
 void map_terrain_backup(void)
 {
-    map_grid_copy_u32(terrain_grid.items, terrain_grid_backup.items);
+    map_grid_backup_region_start(&backup_region);
 }
 
 void map_terrain_restore(void)
 {
-    map_grid_copy_u32(terrain_grid_backup.items, terrain_grid.items);
+    map_grid_backup_region_restore_u32(&backup_region, terrain_grid_backup.items, terrain_grid.items);
+    map_water_supply_clear();
+}
+
+int map_terrain_backup_size(void)
+{
+    return map_grid_backup_region_saved_size(&backup_region, sizeof(terrain_grid_backup.items[0]));
+}
+
+void map_terrain_save_backup(buffer *buf)
+{
+    map_grid_backup_region_save(&backup_region, terrain_grid_backup.items, sizeof(terrain_grid_backup.items[0]), buf);
+}
+
+void map_terrain_load_backup(buffer *buf)
+{
+    map_grid_backup_region_load(&backup_region, terrain_grid_backup.items, sizeof(terrain_grid_backup.items[0]), buf);
 }
 
 void map_terrain_clear(void)
 {
+    map_grid_backup_region_stop(&backup_region);
     map_grid_clear_u32(terrain_grid.items);
+    map_water_supply_clear();
 }
 
 void map_terrain_init_outside_map(void)
@@ -471,10 +506,12 @@ static void determine_original_trees(buffer *images, int legacy_buffer)
 
 void map_terrain_load_state(buffer *buf, int expanded_terrain_data, buffer *images, int legacy_image_buffer)
 {
+    map_grid_backup_region_stop(&backup_region);
     if (expanded_terrain_data) {
         map_grid_load_state_u32(terrain_grid.items, buf);
     } else {
         map_grid_load_state_u16_to_u32(terrain_grid.items, buf);
     }
     determine_original_trees(images, legacy_image_buffer);
+    map_water_supply_clear();
 }
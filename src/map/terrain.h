@@ -137,6 +137,12 @@ void map_terrain_backup(void);
 
 void map_terrain_restore(void);
 
+int map_terrain_backup_size(void);
+
+void map_terrain_save_backup(buffer *buf);
+
+void map_terrain_load_backup(buffer *buf);
+
 void map_terrain_clear(void);
 
 void map_terrain_init_outside_map(void);
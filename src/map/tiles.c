@@ -36,6 +36,15 @@ static int aqueduct_include_construction = 0;
 static int highway_top_tile_offsets[4] = { 0, -GRID_SIZE, -1, -GRID_SIZE - 1 };
 static int elevation_recalculate_trees = 0;
 
+static struct {
+    grid_u8 tiles;
+    int active;
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} marked_for_update;
+
 static int is_clear(int x, int y, int size, int disallowed_terrain, int check_figure, int check_image)
 {
     if (!map_grid_is_inside(x, y, size)) {
@@ -85,6 +94,57 @@ static void foreach_region_tile(int x_min, int y_min, int x_max, int y_max,
     }
 }
 
+void map_tiles_mark_for_update(int x_min, int y_min, int x_max, int y_max)
+{
+    map_grid_bound_area(&x_min, &y_min, &x_max, &y_max);
+    if (x_min > x_max || y_min > y_max) {
+        return;
+    }
+    for (int yy = y_min; yy <= y_max; yy++) {
+        int grid_offset = map_grid_offset(x_min, yy);
+        for (int xx = x_min; xx <= x_max; xx++, grid_offset++) {
+            marked_for_update.tiles.items[grid_offset] = 1;
+        }
+    }
+    if (!marked_for_update.active) {
+        marked_for_update.active = 1;
+        marked_for_update.x_min = x_min;
+        marked_for_update.y_min = y_min;
+        marked_for_update.x_max = x_max;
+        marked_for_update.y_max = y_max;
+        return;
+    }
+    if (x_min < marked_for_update.x_min) {
+        marked_for_update.x_min = x_min;
+    }
+    if (y_min < marked_for_update.y_min) {
+        marked_for_update.y_min = y_min;
+    }
+    if (x_max > marked_for_update.x_max) {
+        marked_for_update.x_max = x_max;
+    }
+    if (y_max > marked_for_update.y_max) {
+        marked_for_update.y_max = y_max;
+    }
+}
+
+int map_tiles_is_marked_for_update(int grid_offset)
+{
+    return marked_for_update.tiles.items[grid_offset];
+}
+
+static void foreach_marked_tile(void (*callback)(int x, int y, int grid_offset))
+{
+    for (int yy = marked_for_update.y_min; yy <= marked_for_update.y_max; yy++) {
+        int grid_offset = map_grid_offset(marked_for_update.x_min, yy);
+        for (int xx = marked_for_update.x_min; xx <= marked_for_update.x_max; xx++, grid_offset++) {
+            if (marked_for_update.tiles.items[grid_offset]) {
+                callback(xx, yy, grid_offset);
+            }
+        }
+    }
+}
+
 static int is_all_terrain_in_area(int x, int y, int size, int terrain)
 {
     if (!map_grid_is_inside(x, y, size)) {
@@ -854,6 +914,8 @@ int map_tiles_set_highway(int x, int y)
     }
     foreach_region_tile(x - 1, y - 1, x + 2, y + 2, set_highway_image);
     foreach_region_tile(x - 1, y - 1, x + 2, y + 2, set_road_image);
+    // Roads within three tiles of a highway are paved
+    map_tiles_mark_for_update(x - 3, y - 3, x + 4, y + 4);
     return items;
 }
 
@@ -878,6 +940,9 @@ static int clear_highway_from_top(int grid_offset, int measure_only)
         }
     }
     foreach_region_tile(x - 1, y - 1, x + 2, y + 2, set_highway_image);
+    if (cleared && !measure_only) {
+        map_tiles_mark_for_update(x - 3, y - 3, x + 4, y + 4);
+    }
     return cleared;
 }
 
@@ -1380,6 +1445,50 @@ void map_tiles_add_entry_exit_flags(void)
     }
 }
 
+static void clear_marked_tile(int x, int y, int grid_offset)
+{
+    marked_for_update.tiles.items[grid_offset] = 0;
+}
+
+static int road_paving_changed(int grid_offset)
+{
+    if (!map_terrain_is(grid_offset, TERRAIN_ROAD) ||
+        map_terrain_is(grid_offset, TERRAIN_WATER | TERRAIN_BUILDING | TERRAIN_AQUEDUCT) ||
+        map_property_is_plaza_earthquake_or_overgrown_garden(grid_offset)) {
+        return 0;
+    }
+    int is_drawn_paved = map_image_at(grid_offset) < image_group(GROUP_TERRAIN_ROAD) + 49;
+    int desirability = map_desirability_get(grid_offset);
+    if (desirability > 4 || (desirability > 0 && map_terrain_is(grid_offset, TERRAIN_FOUNTAIN_RANGE))) {
+        return !is_drawn_paved;
+    }
+    // Highway changes mark the nearby roads themselves, so only check for highways when the road may lose its paving
+    return is_drawn_paved && !map_tiles_is_paved_road(grid_offset);
+}
+
+static void update_marked_road_image(int x, int y, int grid_offset)
+{
+    if (marked_for_update.tiles.items[grid_offset] || road_paving_changed(grid_offset)) {
+        set_road_image(x, y, grid_offset);
+    }
+}
+
+void map_tiles_update_marked(void)
+{
+    // Paving depends on desirability and fountain coverage, which change all over the city
+    foreach_map_tile(update_marked_road_image);
+    if (!marked_for_update.active) {
+        return;
+    }
+    map_grid_bound_area(&marked_for_update.x_min, &marked_for_update.y_min,
+        &marked_for_update.x_max, &marked_for_update.y_max);
+    foreach_marked_tile(set_highway_image);
+    foreach_marked_tile(set_water_image);
+    foreach_region_tile(marked_for_update.x_min, marked_for_update.y_min,
+        marked_for_update.x_max, marked_for_update.y_max, clear_marked_tile);
+    marked_for_update.active = 0;
+}
+
 void map_tiles_update_all(void)
 {
     map_tiles_remove_entry_exit_flags();
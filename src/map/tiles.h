@@ -54,4 +54,15 @@ void map_tiles_remove_entry_exit_flags(void);
 
 void map_tiles_update_all(void);
 
+/**
+ * Marks an area whose road, highway, water and connectable images need to be refreshed on the next monthly update
+ */
+void map_tiles_mark_for_update(int x_min, int y_min, int x_max, int y_max);
+int map_tiles_is_marked_for_update(int grid_offset);
+
+/**
+ * Refreshes the images of the tiles marked for update and of the roads whose paving changed
+ */
+void map_tiles_update_marked(void);
+
 #endif // MAP_TILES_H
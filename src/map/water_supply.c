@@ -5,7 +5,9 @@
 #include "building/image.h"
 #include "building/monument.h"
 #include "building/list.h"
+#include "core/array.h"
 #include "core/image.h"
+#include "core/log.h"
 #include "map/aqueduct.h"
 #include "map/building_tiles.h"
 #include "map/data.h"
@@ -22,7 +24,8 @@
 
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
-#define MAX_QUEUE 1000
+#define MAX_CHANGED_AQUEDUCT_TILES 1000
+#define MAX_AQUEDUCT_NETWORKS 65535
 #define RESERVOIR_RADIUS 10
 #define WELL_RADIUS 2
 #define LATRINES_RADIUS 3
@@ -31,95 +34,272 @@
 static const int ADJACENT_OFFSETS[] = { -GRID_SIZE, 1, GRID_SIZE, -1 };
 static const int CONNECTOR_OFFSETS[] = { OFFSET(1,-1), OFFSET(3,1), OFFSET(1,3), OFFSET(-1,1) };
 
+enum {
+    NETWORK_NOT_DRAWN = 0,
+    NETWORK_DRAWN_DRY = 1,
+    NETWORK_DRAWN_WET = 2
+};
+
+// Connected aqueduct tiles form a network. Networks are only re-flooded when their tiles change.
 static struct {
-    int items[MAX_QUEUE];
-    int head;
-    int tail;
-} queue;
+    grid_u16 ids;
+    int next_id;
+    int is_valid;
+    int changed_tiles[MAX_CHANGED_AQUEDUCT_TILES];
+    int num_changed_tiles;
+    uint8_t has_water[MAX_AQUEDUCT_NETWORKS + 1];
+    uint8_t drawn_state[MAX_AQUEDUCT_NETWORKS + 1];
+    int queue[GRID_SIZE * GRID_SIZE];
+} network;
+
+typedef struct {
+    int active;
+    int x;
+    int y;
+    int size;
+    int radius;
+    unsigned int last_update;
+} coverage_area;
+
+// Reference counts of the buildings covering each tile. The areas are indexed by building id.
+typedef struct {
+    grid_u16 count;
+    array(coverage_area) areas;
+    int num_active;
+    int num_updated;
+    unsigned int current_update;
+} coverage;
+
+static coverage reservoir_coverage;
+static coverage fountain_coverage;
+static coverage well_coverage;
+static coverage latrines_coverage;
+static int coverage_is_valid;
+
+static void reset_coverage(coverage *c)
+{
+    map_grid_clear_u16(c->count.items);
+    array_init(c->areas, 256, 0, 0);
+    c->num_active = 0;
+    c->num_updated = 0;
+    c->current_update = 0;
+}
+
+static void validate_coverage(void)
+{
+    if (coverage_is_valid) {
+        return;
+    }
+    reset_coverage(&reservoir_coverage);
+    reset_coverage(&fountain_coverage);
+    reset_coverage(&well_coverage);
+    reset_coverage(&latrines_coverage);
+    coverage_is_valid = 1;
+}
 
-static void mark_well_access(int well_id, int radius)
+static void change_coverage_count(coverage *c, const coverage_area *area, int delta)
 {
-    building *well = building_get(well_id);
     int x_min, y_min, x_max, y_max;
-    map_grid_get_area(well->x, well->y, 1, radius, &x_min, &y_min, &x_max, &y_max);
+    map_grid_get_area(area->x, area->y, area->size, area->radius, &x_min, &y_min, &x_max, &y_max);
 
     for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int building_id = map_building_at(map_grid_offset(xx, yy));
-            if (building_id) {
-                building_get(building_id)->has_well_access = 1;
-            }
+        int grid_offset = map_grid_offset(x_min, yy);
+        for (int xx = x_min; xx <= x_max; xx++, grid_offset++) {
+            c->count.items[grid_offset] += delta;
         }
     }
 }
 
-static void mark_latrines_access(int latrines_id, int radius)
+static void start_coverage_update(coverage *c)
 {
-    building *latrines = building_get(latrines_id);
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(latrines->x, latrines->y, 1, radius, &x_min, &y_min, &x_max, &y_max);
+    c->current_update++;
+    c->num_updated = 0;
+}
 
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int building_id = map_building_at(map_grid_offset(xx, yy));
-            if (building_id && latrines->num_workers > 0) {
-                building_get(building_id)->has_latrines_access = 1;
+static void set_coverage(coverage *c, int building_id, int x, int y, int size, int radius)
+{
+    while (c->areas.size <= building_id) {
+        if (!array_advance(c->areas)) {
+            log_error("Unable to allocate memory for water coverage", 0, 0);
+            return;
+        }
+    }
+    coverage_area *area = array_item(c->areas, building_id);
+    if (!area->active || area->x != x || area->y != y || area->size != size || area->radius != radius) {
+        if (area->active) {
+            change_coverage_count(c, area, -1);
+        } else {
+            c->num_active++;
+        }
+        area->active = 1;
+        area->x = x;
+        area->y = y;
+        area->size = size;
+        area->radius = radius;
+        change_coverage_count(c, area, 1);
+    }
+    area->last_update = c->current_update;
+    c->num_updated++;
+}
+
+static void finish_coverage_update(coverage *c)
+{
+    if (c->num_updated == c->num_active) {
+        return;
+    }
+    coverage_area *area;
+    array_foreach(c->areas, area) {
+        if (area->active && area->last_update != c->current_update) {
+            change_coverage_count(c, area, -1);
+            area->active = 0;
+            c->num_active--;
+        }
+    }
+}
+
+static int has_coverage(const coverage *c, int x, int y, int size)
+{
+    for (int dy = 0; dy < size; dy++) {
+        for (int dx = 0; dx < size; dx++) {
+            int grid_offset = map_grid_offset(x + dx, y + dy);
+            if (map_grid_is_valid_offset(grid_offset) && c->count.items[grid_offset]) {
+                return 1;
             }
         }
     }
+    return 0;
+}
+
+void map_water_supply_clear(void)
+{
+    network.is_valid = 0;
+    network.num_changed_tiles = 0;
+    coverage_is_valid = 0;
+}
+
+void map_water_supply_aqueduct_changed(int grid_offset)
+{
+    if (!network.is_valid) {
+        return;
+    }
+    if (network.num_changed_tiles >= MAX_CHANGED_AQUEDUCT_TILES) {
+        network.is_valid = 0;
+        return;
+    }
+    network.changed_tiles[network.num_changed_tiles++] = grid_offset;
 }
 
 void map_water_supply_update_buildings(void)
 {
+    validate_coverage();
+
+    start_coverage_update(&well_coverage);
+    for (building *b = building_first_of_type(BUILDING_WELL); b; b = b->next_of_type) {
+        if (b->state == BUILDING_STATE_IN_USE) {
+            set_coverage(&well_coverage, b->id, b->x, b->y, 1, map_water_supply_well_radius());
+        }
+    }
+    finish_coverage_update(&well_coverage);
+
+    start_coverage_update(&latrines_coverage);
+    for (building *b = building_first_of_type(BUILDING_LATRINES); b; b = b->next_of_type) {
+        if (b->state == BUILDING_STATE_IN_USE && b->num_workers > 0) {
+            set_coverage(&latrines_coverage, b->id, b->x, b->y, 1, map_water_supply_latrines_radius());
+        }
+    }
+    finish_coverage_update(&latrines_coverage);
+
     for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
         for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
             if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
                 continue;
             }
-            b->has_water_access = 0;
-            b->has_well_access = 0;
-            b->has_latrines_access = 0;
-            if (map_terrain_exists_tile_in_area_with_type(
-                b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE)) {
-                b->has_water_access = 1;
-            }
+            b->has_water_access = map_terrain_exists_tile_in_area_with_type(
+                b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE);
+            b->has_well_access = has_coverage(&well_coverage, b->x, b->y, b->size);
+            b->has_latrines_access = has_coverage(&latrines_coverage, b->x, b->y, b->size);
         }
     }
 
     for (building *b = building_first_of_type(BUILDING_CONCRETE_MAKER); b; b = b->next_of_type) {
-        b->has_well_access = 0;
+        b->has_well_access = has_coverage(&well_coverage, b->x, b->y, b->size);
     }
+}
 
-    for (building *b = building_first_of_type(BUILDING_WELL); b; b = b->next_of_type) {
-        if (b->state == BUILDING_STATE_IN_USE) {
-            mark_well_access(b->id, map_water_supply_well_radius());
-        }
+int map_water_supply_has_well_coverage(int x, int y, int size)
+{
+    if (!coverage_is_valid) {
+        return 0;
     }
+    return has_coverage(&well_coverage, x, y, size);
+}
 
-    for (building *b = building_first_of_type(BUILDING_LATRINES); b; b = b->next_of_type) {
-        if (b->state == BUILDING_STATE_IN_USE) {
-            mark_latrines_access(b->id, map_water_supply_latrines_radius());
+static void flood_network(int grid_offset, int id)
+{
+    int head = 0;
+    int tail = 0;
+    network.ids.items[grid_offset] = id;
+    network.queue[tail++] = grid_offset;
+    while (head < tail) {
+        int offset = network.queue[head++];
+        for (int i = 0; i < 4; i++) {
+            int new_offset = offset + ADJACENT_OFFSETS[i];
+            if (map_terrain_is(new_offset, TERRAIN_AQUEDUCT) && network.ids.items[new_offset] != id) {
+                network.ids.items[new_offset] = id;
+                network.queue[tail++] = new_offset;
+            }
         }
     }
 }
 
-static void set_all_aqueducts_to_no_water(void)
+static void rebuild_networks(void)
 {
+    map_grid_clear_u16(network.ids.items);
+    memset(network.drawn_state, NETWORK_NOT_DRAWN, sizeof(network.drawn_state));
+    network.next_id = 1;
+    network.num_changed_tiles = 0;
+    network.is_valid = 1;
+
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
-                map_aqueduct_set_water_access(grid_offset, 0);
-                int image_id = map_image_at(grid_offset);
-                if (image_id < image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
-                    map_image_set(grid_offset, image_id + 15);
-                } else if(map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
-                    image_id = map_tiles_highway_get_aqueduct_image(grid_offset);
-                    map_image_set(grid_offset, image_id);
-                }
+            if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT) && !network.ids.items[grid_offset]) {
+                flood_network(grid_offset, network.next_id++);
+            }
+        }
+    }
+}
+
+static void update_changed_networks(void)
+{
+    // Every changed tile splits into at most four new networks
+    if (!network.is_valid || network.next_id + 4 * network.num_changed_tiles > MAX_AQUEDUCT_NETWORKS) {
+        rebuild_networks();
+        return;
+    }
+    int first_new_id = network.next_id;
+    for (int i = 0; i < network.num_changed_tiles; i++) {
+        int grid_offset = network.changed_tiles[i];
+        if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
+            if (network.ids.items[grid_offset] < first_new_id) {
+                flood_network(grid_offset, network.next_id++);
+            }
+            continue;
+        }
+        network.ids.items[grid_offset] = 0;
+        for (int d = 0; d < 4; d++) {
+            int new_offset = grid_offset + ADJACENT_OFFSETS[d];
+            if (map_terrain_is(new_offset, TERRAIN_AQUEDUCT) && network.ids.items[new_offset] < first_new_id) {
+                flood_network(new_offset, network.next_id++);
             }
         }
     }
+    network.num_changed_tiles = 0;
+}
+
+static int network_at(int grid_offset)
+{
+    return map_terrain_is(grid_offset, TERRAIN_AQUEDUCT) ? network.ids.items[grid_offset] : 0;
 }
 
 static int is_valid_reservoir_connection(int grid_offset)
@@ -128,72 +308,115 @@ static int is_valid_reservoir_connection(int grid_offset)
     return xy != EDGE_X0Y0 && xy != EDGE_X2Y0 && xy != EDGE_X0Y2 && xy != EDGE_X2Y2;
 }
 
-static void fill_aqueducts_from_offset(int grid_offset)
+static void fill_reservoirs_from_network(int network_id)
 {
-    if (!map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
-        building *b = building_get(map_building_at(grid_offset));
-        if (b->id && b->type == BUILDING_RESERVOIR) {
-            if (!b->has_water_access && is_valid_reservoir_connection(grid_offset)) {
+    for (building *b = building_first_of_type(BUILDING_RESERVOIR); b; b = b->next_of_type) {
+        if (b->has_water_access) {
+            continue;
+        }
+        for (int d = 0; d < 4; d++) {
+            if (network_at(b->grid_offset + CONNECTOR_OFFSETS[d]) == network_id) {
                 b->has_water_access = 2;
+                break;
             }
         }
-        return;
     }
-    memset(&queue, 0, sizeof(queue));
-    int guard = 0;
-    int next_offset;
+}
 
-    do {
-        if (++guard >= GRID_SIZE * GRID_SIZE) {
-            break;
+static void fill_from_connector(int grid_offset)
+{
+    int network_id = network_at(grid_offset);
+    if (network_id) {
+        if (!network.has_water[network_id]) {
+            network.has_water[network_id] = 1;
+            fill_reservoirs_from_network(network_id);
+        }
+        return;
+    }
+    building *b = building_get(map_building_at(grid_offset));
+    if (b->id && b->type == BUILDING_RESERVOIR) {
+        if (!b->has_water_access && is_valid_reservoir_connection(grid_offset)) {
+            b->has_water_access = 2;
         }
-        map_aqueduct_set_water_access(grid_offset, 1);
-        int image_id = map_image_at(grid_offset);
+    }
+}
+
+static void set_aqueduct_water(int grid_offset, int has_water)
+{
+    map_aqueduct_set_water_access(grid_offset, has_water);
+    int image_id = map_image_at(grid_offset);
+    if (has_water) {
         if (map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
-            image_id = map_tiles_highway_get_aqueduct_image(grid_offset);
-            map_image_set(grid_offset, image_id);
+            map_image_set(grid_offset, map_tiles_highway_get_aqueduct_image(grid_offset));
         } else if (image_id >= image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
             map_image_set(grid_offset, image_id - 15);
         }
-        next_offset = -1;
-        for (int i = 0; i < 4; i++) {
-            int new_offset = grid_offset + ADJACENT_OFFSETS[i];
-            building *b = building_get(map_building_at(new_offset));
-            if (b->id && b->type == BUILDING_RESERVOIR) {
-                if (!b->has_water_access && is_valid_reservoir_connection(new_offset)) {
-                    b->has_water_access = 2;
-                }
-            } else if (map_terrain_is(new_offset, TERRAIN_AQUEDUCT)) {
-                if (!map_aqueduct_has_water_access_at(new_offset)) {
-                    if (next_offset == -1) {
-                        next_offset = new_offset;
-                    } else {
-                        queue.items[queue.tail++] = new_offset;
-                        if (queue.tail >= MAX_QUEUE) {
-                            queue.tail = 0;
-                        }
-                    }
-                }
+    } else if (image_id < image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER)) {
+        map_image_set(grid_offset, image_id + 15);
+    } else if (map_terrain_is(grid_offset, TERRAIN_HIGHWAY)) {
+        map_image_set(grid_offset, map_tiles_highway_get_aqueduct_image(grid_offset));
+    }
+}
+
+static void draw_changed_networks(void)
+{
+    int has_changes = 0;
+    for (int id = 1; id < network.next_id; id++) {
+        int state = network.has_water[id] ? NETWORK_DRAWN_WET : NETWORK_DRAWN_DRY;
+        if (network.drawn_state[id] != state) {
+            has_changes = 1;
+            break;
+        }
+    }
+    if (!has_changes) {
+        return;
+    }
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            int network_id = network_at(grid_offset);
+            if (!network_id) {
+                continue;
+            }
+            int state = network.has_water[network_id] ? NETWORK_DRAWN_WET : NETWORK_DRAWN_DRY;
+            if (network.drawn_state[network_id] != state) {
+                set_aqueduct_water(grid_offset, network.has_water[network_id]);
             }
         }
-        if (next_offset == -1) {
-            if (queue.head == queue.tail) {
-                return;
+    }
+    for (int id = 1; id < network.next_id; id++) {
+        network.drawn_state[id] = network.has_water[id] ? NETWORK_DRAWN_WET : NETWORK_DRAWN_DRY;
+    }
+}
+
+static void update_range_terrain(void)
+{
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            int old_terrain = map_terrain_get(grid_offset);
+            int terrain = old_terrain & ~(TERRAIN_FOUNTAIN_RANGE | TERRAIN_RESERVOIR_RANGE);
+            if (reservoir_coverage.count.items[grid_offset]) {
+                terrain |= TERRAIN_RESERVOIR_RANGE;
             }
-            next_offset = queue.items[queue.head++];
-            if (queue.head >= MAX_QUEUE) {
-                queue.head = 0;
+            if (fountain_coverage.count.items[grid_offset]) {
+                terrain |= TERRAIN_FOUNTAIN_RANGE;
+            }
+            // setting every tile would mark the whole map as changed for the undo backup
+            if ((terrain ^ old_terrain) & (TERRAIN_FOUNTAIN_RANGE | TERRAIN_RESERVOIR_RANGE)) {
+                map_terrain_set(grid_offset, terrain);
             }
         }
-        grid_offset = next_offset;
-    } while (next_offset > -1);
+    }
 }
 
 void map_water_supply_update_reservoir_fountain(void)
 {
-    map_terrain_remove_all(TERRAIN_FOUNTAIN_RANGE | TERRAIN_RESERVOIR_RANGE);
+    validate_coverage();
+    update_changed_networks();
+    memset(network.has_water, 0, network.next_id);
+
     // reservoirs
-    set_all_aqueducts_to_no_water();
     for (building *b = building_first_of_type(BUILDING_RESERVOIR); b; b = b->next_of_type) {
         if (b->state != BUILDING_STATE_IN_USE) {
             continue;
@@ -216,25 +439,30 @@ void map_water_supply_update_reservoir_fountain(void)
                 b->has_water_access = 1;
                 changed = 1;
                 for (int d = 0; d < 4; d++) {
-                    fill_aqueducts_from_offset(b->grid_offset + CONNECTOR_OFFSETS[d]);
+                    fill_from_connector(b->grid_offset + CONNECTOR_OFFSETS[d]);
                 }
             }
         }
     }
+    draw_changed_networks();
+
     // mark reservoir ranges
+    start_coverage_update(&reservoir_coverage);
     for (building *b = building_first_of_type(BUILDING_RESERVOIR); b; b = b->next_of_type) {
         if (b->state == BUILDING_STATE_IN_USE && b->has_water_access) {
-            map_terrain_add_with_radius(b->x, b->y, 3, map_water_supply_reservoir_radius(), TERRAIN_RESERVOIR_RANGE);
+            set_coverage(&reservoir_coverage, b->id, b->x, b->y, 3, map_water_supply_reservoir_radius());
         }
     }
 
     // Neptune GT module 2 bonus
     if (building_monument_gt_module_is_active(NEPTUNE_MODULE_2_CAPACITY_AND_WATER)) {
         building *b = building_get(building_monument_get_neptune_gt());
-        map_terrain_add_with_radius(b->x, b->y, 7, map_water_supply_reservoir_radius(), TERRAIN_RESERVOIR_RANGE);
+        set_coverage(&reservoir_coverage, b->id, b->x, b->y, 7, map_water_supply_reservoir_radius());
     }
+    finish_coverage_update(&reservoir_coverage);
 
     // fountains
+    start_coverage_update(&fountain_coverage);
     for (building *b = building_first_of_type(BUILDING_FOUNTAIN); b; b = b->next_of_type) {
         if (b->state != BUILDING_STATE_IN_USE) {
             continue;
@@ -249,14 +477,17 @@ void map_water_supply_update_reservoir_fountain(void)
             b->upgrade_level = 0;
         }
         map_building_tiles_add(b->id, b->x, b->y, 1, building_image_get(b), TERRAIN_BUILDING);
-        if (map_terrain_is(b->grid_offset, TERRAIN_RESERVOIR_RANGE) && b->num_workers) {
+        if (reservoir_coverage.count.items[b->grid_offset] && b->num_workers) {
             b->has_water_access = 1;
-            map_terrain_add_with_radius(b->x, b->y, 1,
-                map_water_supply_fountain_radius(), TERRAIN_FOUNTAIN_RANGE);
+            set_coverage(&fountain_coverage, b->id, b->x, b->y, 1, map_water_supply_fountain_radius());
         } else {
             b->has_water_access = 0;
         }
     }
+    finish_coverage_update(&fountain_coverage);
+
+    update_range_terrain();
+
     // Ponds
     static const building_type ponds[] = { BUILDING_SMALL_POND, BUILDING_LARGE_POND };
     for (int i = 0; i < 2; i++) {
@@ -1,9 +1,21 @@
 #ifndef MAP_WATER_SUPPLY_H
 #define MAP_WATER_SUPPLY_H
 
+/**
+ * Forgets the aqueduct networks and water coverage, which will be rebuilt from scratch on the next update
+ */
+void map_water_supply_clear(void);
+
+/**
+ * Notifies that an aqueduct was added to or removed from a tile, so its network needs to be re-flooded
+ * @param grid_offset Offset of the changed tile
+ */
+void map_water_supply_aqueduct_changed(int grid_offset);
+
 void map_water_supply_update_buildings(void);
 void map_water_supply_update_reservoir_fountain(void);
 int map_water_supply_has_aqueduct_access(int grid_offset);
+int map_water_supply_has_well_coverage(int x, int y, int size);
 
 enum {
     BUILDING_NECESSARY = 0,
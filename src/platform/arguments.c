@@ -8,6 +8,11 @@
 #define DISPLAY_SCALE_ERROR_MESSAGE "Option --display-scale must be followed by a scale value between 0.5 and 5"
 #define WINDOWED_AND_FULLSCREEN_ERROR_MESSAGE "Option --windowed and --fullscreen cannot both be specified"
 #define DISPLAY_ID_ERROR_MESSAGE "Option --display must be followed by a number indicating the display, starting from 0"
+#define HASH_TRACE_ERROR_MESSAGE "Option --hash-trace must be followed by a saved game, a number of ticks and an interval"
+#define REPLAY_ERROR_MESSAGE "Option --replay must be followed by a saved game, a replay log and a number of ticks"
+#define DETERMINISM_CHECK_ERROR_MESSAGE "Option --determinism-check must be followed by a saved game and a number of ticks"
+#define SAVE_RELOAD_CHECK_ERROR_MESSAGE "Option --save-reload-check must be followed by a saved game and two numbers of ticks"
+#define SAVE_BENCHMARK_ERROR_MESSAGE "Option --save-benchmark must be followed by a saved game and a number of rounds"
 #define UNKNOWN_OPTION_ERROR_MESSAGE "Option %s not recognized"
 
 static void print_log(const char *message)
@@ -74,6 +79,20 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
     output_args->use_software_cursor = 0;
     output_args->force_fullscreen = 0;
     output_args->display_id = 0;
+    output_args->hash_trace_file = 0;
+    output_args->hash_trace_ticks = 0;
+    output_args->hash_trace_interval = 0;
+    output_args->record_replay = 0;
+    output_args->replay_file = 0;
+    output_args->replay_log_file = 0;
+    output_args->replay_ticks = 0;
+    output_args->determinism_check_file = 0;
+    output_args->determinism_check_ticks = 0;
+    output_args->save_reload_check_file = 0;
+    output_args->save_reload_check_save_ticks = 0;
+    output_args->save_reload_check_ticks = 0;
+    output_args->save_benchmark_file = 0;
+    output_args->save_benchmark_rounds = 0;
 
     for (int i = 1; i < argc; i++) {
         // we ignore "-psn" arguments, this is needed to launch the app
@@ -118,6 +137,56 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
                 print_log(DISPLAY_ID_ERROR_MESSAGE);
                 ok = 0;
             }
+        } else if (SDL_strcmp(argv[i], "--hash-trace") == 0) {
+            if (i + 3 < argc) {
+                output_args->hash_trace_file = argv[i + 1];
+                output_args->hash_trace_ticks = SDL_strtol(argv[i + 2], 0, 10);
+                output_args->hash_trace_interval = SDL_strtol(argv[i + 3], 0, 10);
+                i += 3;
+            } else {
+                print_log(HASH_TRACE_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--record-replay") == 0) {
+            output_args->record_replay = 1;
+        } else if (SDL_strcmp(argv[i], "--replay") == 0) {
+            if (i + 3 < argc) {
+                output_args->replay_file = argv[i + 1];
+                output_args->replay_log_file = argv[i + 2];
+                output_args->replay_ticks = SDL_strtol(argv[i + 3], 0, 10);
+                i += 3;
+            } else {
+                print_log(REPLAY_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--determinism-check") == 0) {
+            if (i + 2 < argc) {
+                output_args->determinism_check_file = argv[i + 1];
+                output_args->determinism_check_ticks = SDL_strtol(argv[i + 2], 0, 10);
+                i += 2;
+            } else {
+                print_log(DETERMINISM_CHECK_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--save-reload-check") == 0) {
+            if (i + 3 < argc) {
+                output_args->save_reload_check_file = argv[i + 1];
+                output_args->save_reload_check_save_ticks = SDL_strtol(argv[i + 2], 0, 10);
+                output_args->save_reload_check_ticks = SDL_strtol(argv[i + 3], 0, 10);
+                i += 3;
+            } else {
+                print_log(SAVE_RELOAD_CHECK_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--save-benchmark") == 0) {
+            if (i + 2 < argc) {
+                output_args->save_benchmark_file = argv[i + 1];
+                output_args->save_benchmark_rounds = SDL_strtol(argv[i + 2], 0, 10);
+                i += 2;
+            } else {
+                print_log(SAVE_BENCHMARK_ERROR_MESSAGE);
+                ok = 0;
+            }
         } else if (SDL_strcmp(argv[i], "--windowed") == 0) {
             output_args->force_windowed = 1;
         } else if (SDL_strcmp(argv[i], "--asset-previewer") == 0) {
@@ -165,6 +234,19 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
         print_log("          Enables joystick support");
         print_log("--software-cursor");
         print_log("          Uses a software cursor instead of the default hardware cursor");
+        print_log("--hash-trace SAVEGAME TICKS INTERVAL");
+        print_log("          Runs TICKS game ticks from SAVEGAME and prints the state hashes every INTERVAL ticks");
+        print_log("--record-replay");
+        print_log("          Saves every started game to replay.svx and records its commands to replay.rpl");
+        print_log("--replay SAVEGAME LOG TICKS");
+        print_log("          Runs TICKS game ticks from SAVEGAME with the commands from LOG and prints the state hashes");
+        print_log("--determinism-check SAVEGAME TICKS");
+        print_log("          Runs TICKS game ticks from SAVEGAME twice and compares the state hashes");
+        print_log("--save-reload-check SAVEGAME SAVE_TICKS TICKS");
+        print_log("          Saves SAVEGAME after SAVE_TICKS game ticks and compares the state hashes of the next TICKS");
+        print_log("          game ticks with the ones after loading that save");
+        print_log("--save-benchmark SAVEGAME ROUNDS");
+        print_log("          Writes and reads SAVEGAME ROUNDS times and prints the compression ratios and speeds");
         print_log("The last argument, if present, is interpreted as data directory for the Caesar 3 installation");
     }
     return ok;
@@ -11,6 +11,20 @@ typedef struct {
     int use_software_cursor;
     int force_fullscreen;
     int display_id;
+    const char *hash_trace_file;
+    int hash_trace_ticks;
+    int hash_trace_interval;
+    int record_replay;
+    const char *replay_file;
+    const char *replay_log_file;
+    int replay_ticks;
+    const char *determinism_check_file;
+    int determinism_check_ticks;
+    const char *save_reload_check_file;
+    int save_reload_check_save_ticks;
+    int save_reload_check_ticks;
+    const char *save_benchmark_file;
+    int save_benchmark_rounds;
 } augustus_args;
 
 int platform_parse_arguments(int argc, char **argv, augustus_args *output_args);
@@ -5,8 +5,12 @@
 #include "core/file.h"
 #include "core/lang.h"
 #include "core/log.h"
+#include "core/performance.h"
 #include "core/time.h"
 #include "game/game.h"
+#include "game/hash_trace.h"
+#include "game/replay.h"
+#include "game/save_benchmark.h"
 #include "game/settings.h"
 #include "game/system.h"
 #include "graphics/screen.h"
@@ -188,6 +192,17 @@ uint64_t system_get_ticks(void)
 #endif
 }
 
+uint64_t system_get_microseconds(void)
+{
+    static Uint64 frequency;
+    if (!frequency) {
+        frequency = SDL_GetPerformanceFrequency();
+    }
+    Uint64 counter = SDL_GetPerformanceCounter();
+    // split to avoid overflowing when multiplying large counters
+    return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+}
+
 #ifdef _WIN32
 #define PLATFORM_ENABLE_PER_FRAME_CALLBACK
 static void platform_per_frame_callback(void)
@@ -201,7 +216,9 @@ static void run_and_draw(void)
     time_millis time_before_run = system_get_ticks();
     time_set_millis(time_before_run);
 
+    performance_start_phase(PERFORMANCE_PHASE_RUN);
     game_run();
+    performance_end_phase(PERFORMANCE_PHASE_RUN);
     game_draw();
     Uint32 time_after_draw = system_get_ticks();
 
@@ -215,8 +232,14 @@ static void run_and_draw(void)
     if (config_get(CONFIG_UI_DISPLAY_FPS)) {
         game_display_fps(data.fps.last_fps);
     }
+    if (performance_is_enabled()) {
+        game_display_performance();
+    }
 
+    performance_start_phase(PERFORMANCE_PHASE_RENDER);
     platform_renderer_render();
+    performance_end_phase(PERFORMANCE_PHASE_RENDER);
+    performance_end_frame();
 }
 
 static void handle_mouse_button(SDL_MouseButtonEvent *event, int is_down)
@@ -423,10 +446,13 @@ static void main_loop(void)
 #ifdef PLATFORM_ENABLE_PER_FRAME_CALLBACK
     platform_per_frame_callback();
 #endif
+    performance_start_frame();
+    performance_start_phase(PERFORMANCE_PHASE_INPUT);
     /* Process event queue */
     while (SDL_PollEvent(&event)) {
         handle_event(&event);
     }
+    performance_end_phase(PERFORMANCE_PHASE_INPUT);
     if (data.quit) {
 #ifdef __EMSCRIPTEN__
         emscripten_cancel_main_loop();
@@ -690,6 +716,32 @@ static void setup(const augustus_args *args)
         exit_with_status(2);
     }
 
+    if (args->hash_trace_file) {
+        // runs the simulation only, without handling input or drawing
+        int traced = game_hash_trace_run(args->hash_trace_file, args->hash_trace_ticks, args->hash_trace_interval);
+        exit_with_status(traced ? 0 : 3);
+    }
+    if (args->replay_file) {
+        int replayed = game_replay_run(args->replay_file, args->replay_log_file, args->replay_ticks);
+        exit_with_status(replayed ? 0 : 3);
+    }
+    if (args->determinism_check_file) {
+        int identical = game_hash_trace_check_determinism(args->determinism_check_file, args->determinism_check_ticks);
+        exit_with_status(identical ? 0 : 3);
+    }
+    if (args->save_reload_check_file) {
+        int identical = game_hash_trace_check_save_reload(args->save_reload_check_file,
+            args->save_reload_check_save_ticks, args->save_reload_check_ticks);
+        exit_with_status(identical ? 0 : 3);
+    }
+    if (args->save_benchmark_file) {
+        int measured = game_save_benchmark_run(args->save_benchmark_file, args->save_benchmark_rounds);
+        exit_with_status(measured ? 0 : 3);
+    }
+    if (args->record_replay) {
+        game_replay_enable_recording();
+    }
+
     data.quit = 0;
     data.active = 1;
 }
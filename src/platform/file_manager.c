@@ -147,10 +147,16 @@ static void copy_file_times(FILE *src, FILE *dst)
 
 #ifdef _WIN32
 #include <direct.h>
+#include <io.h>
 #else
 #include <unistd.h>
 #endif
 
+#if !defined(_WIN32) && !defined(__vita__) && !defined(__SWITCH__) && !defined(__EMSCRIPTEN__)
+#define HAS_MMAP
+#include <sys/mman.h>
+#endif
+
 #ifdef __EMSCRIPTEN__
 static int writing_to_file;
 #endif
@@ -696,6 +702,56 @@ int platform_file_manager_close_file(FILE *stream)
     return result == 0;
 }
 
+void *platform_file_manager_map_file(FILE *stream, size_t *size)
+{
+    *size = 0;
+#if defined(_WIN32)
+    HANDLE file = (HANDLE) _get_osfhandle(_fileno(stream));
+    LARGE_INTEGER file_size;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+        return 0;
+    }
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        return 0;
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    // the view keeps a reference to the mapping
+    CloseHandle(mapping);
+    if (!data) {
+        return 0;
+    }
+    *size = (size_t) file_size.QuadPart;
+    return data;
+#elif defined(HAS_MMAP)
+    int fd = fileno(stream);
+    struct stat file_info;
+    if (fd < 0 || fstat(fd, &file_info) || file_info.st_size <= 0) {
+        return 0;
+    }
+    void *data = mmap(0, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+    *size = file_info.st_size;
+    return data;
+#else
+    return 0;
+#endif
+}
+
+void platform_file_manager_unmap_file(void *data, size_t size)
+{
+    if (!data) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+#elif defined(HAS_MMAP)
+    munmap(data, size);
+#endif
+}
+
 int platform_file_manager_create_directory(const char *name, const char *location, int overwrite)
 {
     char tokenized_name[FILE_NAME_MAX];
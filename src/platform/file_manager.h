@@ -108,6 +108,21 @@ FILE *platform_file_manager_open_asset(const char *asset, const char *mode);
 int platform_file_manager_close_file(FILE *stream);
 
 
+/**
+ * Maps the contents of an open file to memory for reading
+ * @param stream A pointer to the FILE structure to map
+ * @param size Will be set to the size of the mapped file
+ * @return A read-only pointer to the file contents, or NULL if the file can't be mapped on this platform
+ */
+void *platform_file_manager_map_file(FILE *stream, size_t *size);
+
+/**
+ * Unmaps a file mapped with platform_file_manager_map_file
+ * @param data The pointer to the file contents
+ * @param size The size of the mapped file
+ */
+void platform_file_manager_unmap_file(void *data, size_t size);
+
 /**
  * Removes a file
  * @param filename The file to remove
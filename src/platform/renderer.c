@@ -2,6 +2,7 @@
 
 #include "core/calc.h"
 #include "core/config.h"
+#include "core/performance.h"
 #include "core/time.h"
 #include "graphics/renderer.h"
 #include "graphics/screen.h"
@@ -118,8 +119,18 @@ static struct {
     float city_scale;
     int should_correct_texture_offset;
     int disable_linear_filter;
+    SDL_Texture *last_drawn_texture;
 } data;
 
+static void count_draw_call(SDL_Texture *texture)
+{
+    performance_add(PERFORMANCE_COUNTER_DRAW_CALLS, 1);
+    if (texture != data.last_drawn_texture) {
+        data.last_drawn_texture = texture;
+        performance_add(PERFORMANCE_COUNTER_TEXTURE_SWITCHES, 1);
+    }
+}
+
 static int save_screen_buffer(color_t *pixels, int x, int y, int width, int height, int row_width)
 {
     if (data.paused) {
@@ -140,6 +151,7 @@ static void draw_line(int x_start, int x_end, int y_start, int y_end, color_t co
         (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
         (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
         (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA);
+    count_draw_call(0);
     SDL_RenderDrawLine(data.renderer, x_start, y_start, x_end, y_end);
 }
 
@@ -154,6 +166,7 @@ static void draw_rect(int x_start, int x_end, int y_start, int y_end, color_t co
         (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
         (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA);
     SDL_Rect rect = { x_start, y_start, x_end, y_end };
+    count_draw_call(0);
     SDL_RenderDrawRect(data.renderer, &rect);
 }
 
@@ -167,6 +180,7 @@ static void fill_rect(int x_start, int x_end, int y_start, int y_end, color_t co
         (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
         (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
         (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA);
+    count_draw_call(0);
     SDL_Rect rect = { x_start, y_start, x_end, y_end };
     SDL_RenderFillRect(data.renderer, &rect);
 }
@@ -401,6 +415,34 @@ static int create_texture_atlas(const image_atlas_data *atlas_data, int delete_b
     return 1;
 }
 
+static int update_texture_atlas(atlas_type type, int image_index, const color_t *pixels,
+    int x_offset, int y_offset, int width, int height)
+{
+    if (data.paused || !data.texture_lists[type] || image_index >= data.atlas_data[type].num_images) {
+        return 0;
+    }
+    SDL_Texture *texture = data.texture_lists[type][image_index];
+    if (!texture) {
+        return 0;
+    }
+    SDL_Rect rect = { x_offset, y_offset, width, height };
+#ifdef __VITA__
+    color_t *texture_pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, &rect, (void **) &texture_pixels, &pitch) != 0) {
+        return 0;
+    }
+    int texture_width = pitch / sizeof(color_t);
+    for (int y = 0; y < height; y++) {
+        memcpy(&texture_pixels[y * texture_width], &pixels[y * width], width * sizeof(color_t));
+    }
+    SDL_UnlockTexture(texture);
+    return 1;
+#else
+    return SDL_UpdateTexture(texture, &rect, pixels, sizeof(color_t) * width) == 0;
+#endif
+}
+
 static int has_texture_atlas(atlas_type type)
 {
     return data.texture_lists[type] != 0;
@@ -518,6 +560,7 @@ static void draw_texture_advanced(const image *img, float x, float y, color_t co
 
     float scale = scale_x == scale_y ? scale_x : 0.0f;
 
+    count_draw_call(texture);
     set_texture_color_and_scale_mode(texture, color, scale);
 
     x += img->x_offset;
@@ -847,6 +890,7 @@ static void draw_saved_texture(int texture_id, int x, int y)
     }
     SDL_Rect src_coords = { 0, 0, texture_info->width, texture_info->height };
     SDL_Rect dst_coords = { x, y, texture_info->width, texture_info->height };
+    count_draw_call(texture_info->texture);
     SDL_RenderCopy(data.renderer, texture_info->texture, &src_coords, &dst_coords);
 }
 
@@ -995,6 +1039,7 @@ static void draw_silhouetted_texture(const image *img, int x, int y, color_t col
         return;
     }
 
+    count_draw_call(texture);
     set_texture_color_and_scale_mode(texture, color, scale);
 
     x += img->x_offset;
@@ -1178,6 +1223,7 @@ static void create_renderer_interface(void)
     data.renderer_interface.get_image_atlas = get_texture_atlas;
     data.renderer_interface.has_image_atlas = has_texture_atlas;
     data.renderer_interface.free_image_atlas = free_texture_atlas_and_data;
+    data.renderer_interface.update_image_atlas = update_texture_atlas;
     data.renderer_interface.load_unpacked_image = load_unpacked_image;
     data.renderer_interface.free_unpacked_image = free_unpacked_image;
     data.renderer_interface.should_pack_image = should_pack_image;
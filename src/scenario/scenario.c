@@ -211,6 +211,8 @@ void scenario_save_state(buffer *buf)
 {
     int buf_size = scenario_get_state_buffer_size_by_scenario_version(SCENARIO_CURRENT_VERSION);
     uint8_t *buf_data = malloc(buf_size);
+    // unused parts are skipped, so they must not keep whatever the memory held before
+    memset(buf_data, 0, buf_size);
     buffer_init(buf, buf_data, buf_size);
 
     // size
@@ -1609,6 +1609,11 @@ static translation_string all_strings[] = {
     {TR_BUILDING_LATRINES_UNNECESSARY, "These latrines have no purpose here, as there are no houses in range needing them."},
     {TR_BUILDING_LATRINES_NO_HOUSES, "These latrines are unnecessary at the moment, as there are no houses within its service range."},
     {TR_CONFIG_DRAW_ASCLEPIUS, "Draw Rod of Asclepius for health menu"},
+    {TR_CONFIG_DELTA_AUTOSAVES, "Monthly autosave only stores changes since the last yearly checkpoint"},
+    {TR_CONFIG_UNDO_HISTORY_MEMORY, "Memory kept for undoing several constructions (MB):"},
+    {TR_HOTKEY_TOGGLE_PERFORMANCE_OVERLAY, "Toggle performance overlay"},
+    {TR_HOTKEY_SAVE_PERFORMANCE_TRACE, "Save performance trace"},
+    {TR_CONFIG_SAVES, "Save Options"},
 };
 
 void translation_english(const translation_string **strings, int *num_strings)
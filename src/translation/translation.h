@@ -1601,6 +1601,11 @@ typedef enum {
     TR_BUILDING_LATRINES_UNNECESSARY,
     TR_BUILDING_LATRINES_NO_HOUSES,
     TR_CONFIG_DRAW_ASCLEPIUS,
+    TR_CONFIG_DELTA_AUTOSAVES,
+    TR_CONFIG_UNDO_HISTORY_MEMORY,
+    TR_HOTKEY_TOGGLE_PERFORMANCE_OVERLAY,
+    TR_HOTKEY_SAVE_PERFORMANCE_TRACE,
+    TR_CONFIG_SAVES,
     TRANSLATION_MAX_KEY
 } translation_key;
 
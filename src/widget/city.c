@@ -15,6 +15,7 @@
 #include "figure/formation_legion.h"
 #include "figure/roamer_preview.h"
 #include "game/cheats.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "graphics/button.h"
@@ -689,8 +690,10 @@ static void military_map_click(int legion_formation_id, const map_tile *tile)
     }
     int other_formation_id = formation_legion_at_building(tile->grid_offset);
     if (other_formation_id && other_formation_id == legion_formation_id) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_LEGION_ORDERS);
         formation_legion_return_home(m);
     } else {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_LEGION_ORDERS);
         formation_legion_move_to(m, tile);
         sound_speech_play_file("wavs/cohort5.wav");
     }
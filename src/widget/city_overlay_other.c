@@ -24,6 +24,7 @@
 #include "map/property.h"
 #include "map/random.h"
 #include "map/terrain.h"
+#include "map/water_supply.h"
 #include "scenario/property.h"
 #include "translation/translation.h"
 #include "widget/city_draw_highway.h"
@@ -570,7 +571,8 @@ static int draw_footprint_water(int x, int y, float scale, int grid_offset)
     } else if (is_building) {
         building *b = building_get(map_building_at(grid_offset));
         int terrain = map_terrain_get(grid_offset);
-        if (b->id && (b->has_well_access || (b->house_size && b->has_water_access))) {
+        if (b->id && (b->house_size ? b->has_well_access || b->has_water_access :
+            map_water_supply_has_well_coverage(b->x, b->y, b->size))) {
             terrain |= TERRAIN_FOUNTAIN_RANGE;
         }
         int image_offset;
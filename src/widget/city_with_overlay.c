@@ -12,9 +12,11 @@
 #include "figure/roamer_preview.h"
 #include "game/resource.h"
 #include "game/state.h"
+#include "game/time.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 #include "graphics/renderer.h"
+#include "graphics/window.h"
 #include "map/bridge.h"
 #include "map/building.h"
 #include "map/figure.h"
@@ -37,9 +39,29 @@
 #include "widget/city_without_overlay.h"
 #include "widget/city_draw_highway.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 static const city_overlay *overlay = 0;
 static float scale = SCALE_NONE;
 
+// The overlay values of a building only change with the game state, so they are calculated once
+// per game tick instead of for every tile of the building on every frame
+typedef struct {
+    int generation;
+    int show_building;
+    int column_height;
+} overlay_building_values;
+
+static struct {
+    overlay_building_values *buildings;
+    int size;
+    int generation;
+    int overlay_type;
+    int game_tick;
+    int window_invalidations;
+} building_values;
+
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
 static const int ADJACENT_OFFSETS[2][4][7] = {
@@ -150,6 +172,48 @@ void city_with_overlay_update(void)
     select_city_overlay();
 }
 
+static void update_building_values_generation(void)
+{
+    int game_tick = (game_time_total_months() * 16 + game_time_day()) * 50 + game_time_tick();
+    int window_invalidations = window_invalidation_count();
+    if (building_values.generation && building_values.overlay_type == overlay->type &&
+        building_values.game_tick == game_tick && building_values.window_invalidations == window_invalidations) {
+        return;
+    }
+    building_values.overlay_type = overlay->type;
+    building_values.game_tick = game_tick;
+    building_values.window_invalidations = window_invalidations;
+    building_values.generation++;
+}
+
+static const overlay_building_values *get_building_values(building *b)
+{
+    static overlay_building_values no_cache;
+    overlay_building_values *values = &no_cache;
+    if (b->id >= building_values.size) {
+        int size = building_count();
+        overlay_building_values *buildings = realloc(building_values.buildings, sizeof(overlay_building_values) * size);
+        if (buildings) {
+            memset(&buildings[building_values.size], 0,
+                sizeof(overlay_building_values) * (size - building_values.size));
+            building_values.buildings = buildings;
+            building_values.size = size;
+        }
+    }
+    if (b->id < building_values.size) {
+        values = &building_values.buildings[b->id];
+    }
+    if (values == &no_cache || values->generation != building_values.generation) {
+        if (overlay->type == OVERLAY_PROBLEMS) {
+            city_overlay_problems_prepare_building(b);
+        }
+        values->show_building = overlay->show_building(b);
+        values->column_height = values->show_building ? NO_COLUMN : overlay->get_column_height(b);
+        values->generation = building_values.generation;
+    }
+    return values;
+}
+
 static int is_drawable_farmhouse(int grid_offset, int map_orientation)
 {
     if (!map_property_is_draw_tile(grid_offset)) {
@@ -338,10 +402,7 @@ void city_with_overlay_draw_building_footprint(int x, int y, int grid_offset, in
         return;
     }
     building *b = building_get(building_id);
-    if (overlay->type == OVERLAY_PROBLEMS) {
-        city_overlay_problems_prepare_building(b);
-    }
-    if (overlay->show_building(b)) {
+    if (get_building_values(b)->show_building) {
         if (building_is_farm(b->type)) {
             if (is_drawable_farmhouse(grid_offset, city_view_orientation())) {
                 image_draw_isometric_footprint_from_draw_tile(map_image_at(grid_offset), x, y, 0, scale);
@@ -612,10 +673,11 @@ static void draw_building_top(int grid_offset, building *b, int x, int y)
 void city_with_overlay_draw_building_top(int x, int y, int grid_offset)
 {
     building *b = building_get(map_building_at(grid_offset));
-    if (overlay->show_building(b)) {
+    const overlay_building_values *values = get_building_values(b);
+    if (values->show_building) {
         draw_building_top(grid_offset, b, x, y);
     } else {
-        int column_height = overlay->get_column_height(b);
+        int column_height = values->column_height;
         if (column_height != NO_COLUMN) {
             int draw = 1;
             if (building_is_farm(b->type)) {
@@ -783,6 +845,7 @@ void city_with_overlay_draw(const map_tile *tile)
     }
 
     scale = city_view_get_scale() / 100.0f;
+    update_building_values_generation();
 
     int x, y, width, height;
     city_view_get_viewport(&x, &y, &width, &height);
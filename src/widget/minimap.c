@@ -534,6 +534,34 @@ void widget_minimap_update(const minimap_functions *functions)
     graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
 }
 
+void widget_minimap_update_from_pixels(const minimap_functions *functions, const color_t *pixels,
+    int width, int height)
+{
+    data.functions = functions ? functions : &default_functions;
+    prepare_minimap_cache();
+    if (!data.cache.buffer) {
+        return;
+    }
+    clear_minimap();
+    if (width == data.minimap.width * 2 && height == data.minimap.height) {
+        for (int y = 0; y < height; y++) {
+            memcpy(&data.cache.buffer[y * data.cache.stride], &pixels[y * width], sizeof(color_t) * width);
+        }
+    }
+    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
+}
+
+const color_t *widget_minimap_get_pixels(int *width, int *height, int *stride)
+{
+    if (!data.cache.buffer) {
+        return 0;
+    }
+    *width = data.minimap.width * 2;
+    *height = data.minimap.height;
+    *stride = data.cache.stride;
+    return data.cache.buffer;
+}
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height)
 {
     if (!data.cache.buffer) {
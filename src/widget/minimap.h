@@ -3,6 +3,7 @@
 
 #include "building/building.h"
 #include "figure/figure.h"
+#include "graphics/color.h"
 #include "input/mouse.h"
 #include "scenario/property.h"
 
@@ -28,6 +29,25 @@ void widget_minimap_invalidate(void);
 
 void widget_minimap_update(const minimap_functions *functions);
 
+/**
+ * Updates the minimap using pre-rendered pixels instead of drawing the map tiles
+ * @param functions The functions used to position the minimap, only the map size, climate and viewport are used
+ * @param pixels The pixels, as returned by widget_minimap_get_pixels
+ * @param width The width of the pixels, must match the map width of the functions
+ * @param height The height of the pixels, must match the map height of the functions
+ */
+void widget_minimap_update_from_pixels(const minimap_functions *functions, const color_t *pixels,
+    int width, int height);
+
+/**
+ * Gets the pixels drawn by the last minimap update
+ * @param width Receives the width of the minimap in pixels
+ * @param height Receives the height of the minimap in pixels
+ * @param stride Receives the number of pixels of each row in the returned buffer
+ * @return The pixels, or 0 if the minimap has not been drawn
+ */
+const color_t *widget_minimap_get_pixels(int *width, int *height, int *stride);
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height);
 
 void widget_minimap_draw_decorated(int x_offset, int y_offset, int width, int height);
@@ -15,8 +15,10 @@
 #include "core/lang.h"
 #include "core/string.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "game/settings.h"
+#include "game/speed.h"
 #include "game/state.h"
 #include "graphics/arrow_button.h"
 #include "graphics/button.h"
@@ -97,6 +99,7 @@ static struct {
     int is_collapsed;
     sidebar_extra_display info_to_display;
     int game_speed;
+    int actual_game_speed;
     struct {
         int percentage;
         int amount;
@@ -296,6 +299,7 @@ static int update_extra_info(int is_background)
     int changed = 0;
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_GAME_SPEED) {
         changed |= update_extra_info_value(setting_game_speed(), &data.game_speed);
+        changed |= update_extra_info_value(game_speed_get_actual_speed(), &data.actual_game_speed);
     }
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_UNEMPLOYMENT) {
         changed |= update_extra_info_value(city_labor_unemployment_percentage(), &data.unemployment.percentage);
@@ -522,7 +526,12 @@ static void draw_extra_info_panel(void)
         lang_text_draw(45, 2, data.x_offset + 10, y_offset, FONT_NORMAL_WHITE);
         y_offset += EXTRA_INFO_LINE_SPACE + EXTRA_INFO_VERTICAL_PADDING;
 
-        text_draw_percentage(data.game_speed, data.x_offset + 60, y_offset - 2, FONT_NORMAL_GREEN);
+        int width = text_draw_percentage(data.game_speed, data.x_offset + 60, y_offset - 2, FONT_NORMAL_GREEN);
+        if (data.actual_game_speed < data.game_speed) {
+            // the city cannot keep up with the chosen speed
+            text_draw_number(data.actual_game_speed, '(', "%)",
+                data.x_offset + 60 + width, y_offset - 2, FONT_NORMAL_RED, 0);
+        }
 
         y_offset += EXTRA_INFO_VERTICAL_PADDING * 3;
     }
@@ -733,6 +742,7 @@ static void confirm_nothing(int accepted, int checked)
 static void confirm_send_troops(int accepted, int checked)
 {
     if (accepted) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
         formation_legions_dispatch_to_distant_battle();
         window_empire_show();
     }
@@ -741,6 +751,7 @@ static void confirm_send_troops(int accepted, int checked)
 static void confirm_send_goods(int accepted, int checked)
 {
     if (accepted) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
         scenario_request_dispatch(data.selected_request_id);
         if (!checked && city_resource_is_stockpiled(data.selected_resource)) {
             city_resource_toggle_stockpiled(data.selected_resource);
@@ -11,6 +11,7 @@
 #include "core/string.h"
 #include "empire/city.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
@@ -199,6 +200,7 @@ static void confirm_nothing(int accepted, int checked)
 static void confirm_send_troops(int accepted, int checked)
 {
     if (accepted) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
         formation_legions_dispatch_to_distant_battle();
         window_empire_show();
     }
@@ -207,6 +209,7 @@ static void confirm_send_troops(int accepted, int checked)
 static void confirm_send_goods(int accepted, int checked)
 {
     if (accepted) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
         scenario_request_dispatch(selected_request_id);
         if (!checked && city_resource_is_stockpiled(selected_resource)) {
             city_resource_toggle_stockpiled(selected_resource);
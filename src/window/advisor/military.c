@@ -6,6 +6,7 @@
 #include "city/view.h"
 #include "core/calc.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
@@ -260,6 +261,7 @@ static void return_legion_to_fort(int legion_id)
 {
     formation *m = formation_get(formation_for_legion(legion_id));
     if (!m->in_distant_battle && !m->is_at_fort) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_LEGION_ORDERS);
         formation_legion_return_home(m);
         window_invalidate();
     }
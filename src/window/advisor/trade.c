@@ -10,6 +10,7 @@
 #include "core/lang.h"
 #include "core/string.h"
 #include "empire/city.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
@@ -280,6 +281,7 @@ static void apply_policy(int selected_policy)
     if (selected_policy == NO_POLICY) {
         return;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     city_trade_policy_set(data.policy_type, selected_policy);
     sound_speech_play_file(policy_options[data.policy_type].wav_file);
     city_finance_process_sundry(TRADE_POLICY_COST);
@@ -287,6 +287,7 @@ static void set_initial_options(void)
 static int init(void)
 {
     image_load_fonts(encoding_get());
+    text_invalidate_layout_cache();
     set_initial_options();
     update_asset_groups_list();
     create_selection_lists();
@@ -11,6 +11,7 @@
 #include "city/finance.h"
 #include "city/trade_policy.h"
 #include "core/dir.h"
+#include "game/replay.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
@@ -1313,6 +1314,7 @@ static void add_module(int selection)
     if (!selection) {
         return;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     sound_speech_play_file("wavs/oracle.wav");
     building *b = building_get(data.building_id);
     city_finance_process_construction(MODULE_COST);
@@ -24,6 +24,7 @@
 #include "empire/object.h"
 #include "empire/trade_route.h"
 #include "figure/figure.h"
+#include "game/replay.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
@@ -1397,6 +1398,7 @@ static void toggle_resource_state(const generic_button *button)
     int index = button->parameter1;
     building *b = building_get(data.building_id);
     index += scrollbar.scroll_position - 1;
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     resource_type resource;
     if (building_has_supplier_inventory(b->type) || b->type == BUILDING_DOCK) {
         resource = data.stored_resources.items[index];
@@ -1416,6 +1418,7 @@ static void market_orders(const generic_button *button)
 {
     int index = button->parameter1;
     building *b = building_get(data.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     if (index == 0) {
         if (affect_all_button_distribution_state() == ACCEPT_ALL) {
             building_distribution_accept_all_goods(b);
@@ -1430,6 +1433,7 @@ static void storage_toggle_permissions(const generic_button *button)
 {
     int index = button->parameter1;
     building *b = building_get(data.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     building_storage_set_permission(index, b);
     window_invalidate();
 }
@@ -1437,6 +1441,7 @@ static void storage_toggle_permissions(const generic_button *button)
 static void toggle_mantain(int param1, int param2)
 {
     building *b = building_get(data.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     building_storage_set_permission(BUILDING_STORAGE_PERMISSION_WORKER, b);
     window_invalidate();
 }
@@ -1451,6 +1456,7 @@ static void toggle_partial_resource_state(const generic_button *button)
     } else {
         resource = city_resource_get_potential_foods()->items[index + scrollbar.scroll_position - 1];
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     building_storage_cycle_partial_resource_state(b->storage_id, resource);
     window_invalidate();
 }
@@ -1459,6 +1465,7 @@ static void button_stockpiling(const generic_button *button)
 {
     building *b = building_get(data.building_id);
     if (building_is_primary_product_producer(b->type)) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
         building_stockpiling_toggle(b);
     }
     window_invalidate();
@@ -1468,6 +1475,7 @@ static void dock_toggle_route(const generic_button *button)
 {
     int route_id = button->parameter1;
     int can_trade = building_dock_can_trade_with_route(route_id, data.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     building_dock_set_can_trade_with_route(route_id, data.building_id, !can_trade);
     window_invalidate();
 }
@@ -1476,6 +1484,7 @@ static void granary_orders(const generic_button *button)
 {
     int index = button->parameter1;
     int storage_id = building_get(data.building_id)->storage_id;
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     if (index == 0) {
         building_storage_toggle_empty_all(storage_id);
     } else if (index == 1) {
@@ -1491,6 +1500,7 @@ static void granary_orders(const generic_button *button)
 static void warehouse_orders(const generic_button *button)
 {
     int index = button->parameter1;
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     if (index == 0) {
         int storage_id = building_get(data.building_id)->storage_id;
         building_storage_toggle_empty_all(storage_id);
@@ -1608,6 +1618,7 @@ static void apply_policy_land(int selected_policy)
     if (selected_policy == NO_POLICY) {
         return;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     city_trade_policy_set(LAND_TRADE_POLICY, selected_policy);
     sound_speech_play_file(land_trade_policy.wav_file);
     city_finance_process_sundry(TRADE_POLICY_COST);
@@ -1715,6 +1726,7 @@ static void apply_policy_sea(int selected_policy)
     if (selected_policy == NO_POLICY) {
         return;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     city_trade_policy_set(SEA_TRADE_POLICY, selected_policy);
     sound_speech_play_file(sea_trade_policy.wav_file);
     city_finance_process_sundry(TRADE_POLICY_COST);
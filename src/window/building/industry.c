@@ -11,6 +11,7 @@
 #include "core/file.h"
 #include "core/string.h"
 #include "figure/figure.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
@@ -561,6 +562,7 @@ static void city_mint_conversion_changed(int accepted, int checked)
     if (!accepted) {
         return;
     }
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_CONFIRMED_COMMAND);
     building *city_mint = building_get(data.city_mint_id);
     if (city_mint->output_resource_id == RESOURCE_DENARII) {
         city_mint->output_resource_id = RESOURCE_GOLD;
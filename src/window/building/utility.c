@@ -7,6 +7,7 @@
 #include "city/finance.h"
 #include "core/dir.h"
 #include "core/image.h"
+#include "game/replay.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
@@ -434,6 +435,7 @@ static void button_toggle_figure_state(const generic_button *button)
     int index = button->parameter1;
     building *b = building_get(data.building_id);
     if (building_type_is_roadblock(b->type)) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_BUILDING_SETTINGS);
         building_roadblock_set_permission(index, b);
     }
     window_invalidate();
@@ -444,6 +446,7 @@ static void button_toggle_figure_state(const generic_button *button)
 static void button_roadblock_orders(const generic_button *button)
 {
     building *b = building_get(data.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_BUILDING_SETTINGS);
     if (affect_all_button_state() == REJECT_ALL) {
         building_roadblock_accept_none(b);
     } else {
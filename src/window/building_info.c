@@ -17,6 +17,7 @@
 #include "figure/formation_legion.h"
 #include "figure/roamer_preview.h"
 #include "figure/phrase.h"
+#include "game/replay.h"
 #include "game/state.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
@@ -1143,6 +1144,7 @@ static void button_mothball(int param1, int param2)
     building *b = building_get(context.building_id);
     int workers_needed = model_get_building(b->type)->laborers;
     if (workers_needed) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_BUILDING_SETTINGS);
         building_mothball_toggle(b);
         window_invalidate();
     }
@@ -1151,6 +1153,7 @@ static void button_mothball(int param1, int param2)
 static void button_monument_construction(const generic_button *button)
 {
     building *b = building_get(context.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_BUILDING_SETTINGS);
     building_monument_toggle_construction_halted(b);
     window_invalidate();
 }
@@ -1206,6 +1209,7 @@ void window_building_info_depot_select_resource(void)
 void window_building_info_depot_toggle_condition_type(void)
 {
     building *b = building_get(context.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     b->data.depot.current_order.condition.condition_type = (b->data.depot.current_order.condition.condition_type + 1) % 4;
     window_invalidate();
 }
@@ -1213,6 +1217,7 @@ void window_building_info_depot_toggle_condition_type(void)
 void window_building_info_depot_toggle_condition_threshold(void)
 {
     building* b = building_get(context.building_id);
+    game_replay_record_unsupported(REPLAY_UNSUPPORTED_STORAGE_SETTINGS);
     b->data.depot.current_order.condition.threshold = (b->data.depot.current_order.condition.threshold + 4) % 36;
     window_invalidate();
 }
@@ -10,6 +10,7 @@
 #include "city/games.h"
 #include "city/gods.h"
 #include "core/image_group.h"
+#include "game/replay.h"
 #include "game/resource.h"
 #include "graphics/button.h"
 #include "graphics/generic_button.h"
@@ -179,6 +180,7 @@ static void button_close(int param1, int param2)
 static void button_hold_games(int param1, int param2)
 {
     if (data.game_possible) {
+        game_replay_record_unsupported(REPLAY_UNSUPPORTED_FESTIVAL);
         city_games_schedule(city_data.games.selected_games_id);
         close_window();
     }
@@ -56,6 +56,8 @@ static hotkey_widget hotkey_widgets[] = {
     {HOTKEY_SAVE_SCREENSHOT, TR_HOTKEY_SAVE_SCREENSHOT},
     {HOTKEY_SAVE_CITY_SCREENSHOT, TR_HOTKEY_SAVE_CITY_SCREENSHOT},
     {HOTKEY_SAVE_MINIMAP_SCREENSHOT, TR_HOTKEY_SAVE_MINIMAP_SCREENSHOT},
+    {HOTKEY_TOGGLE_PERFORMANCE_OVERLAY, TR_HOTKEY_TOGGLE_PERFORMANCE_OVERLAY},
+    {HOTKEY_SAVE_PERFORMANCE_TRACE, TR_HOTKEY_SAVE_PERFORMANCE_TRACE},
     {HOTKEY_LOAD_FILE, TR_HOTKEY_LOAD_FILE},
     {HOTKEY_SAVE_FILE, TR_HOTKEY_SAVE_FILE},
     {HOTKEY_HEADER, TR_HOTKEY_HEADER_CITY},